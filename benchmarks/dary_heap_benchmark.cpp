@@ -0,0 +1,99 @@
+#include "core_library/emergency_department/dary_heap.hpp"
+#include "core_library/emergency_department/indexed_heap.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+/*
+ * D-ARY HEAP BENCHMARK
+ *
+ * Runs one arrival/treatment trace through:
+ * - binary:  IndexedHeap (array of { key, handle } entries)
+ * - 2-ary / 4-ary / 8-ary: IndexedDaryHeap (keys and handles in
+ *   parallel arrays, children groups aligned to cache lines)
+ *
+ * Trace of `ops` operations:
+ * - first half: 2 arrivals for every treatment (the queue builds up)
+ * - second half: 2 treatments for every arrival (the queue drains)
+ * Keys are built like PriorityQueue does:
+ *   [ triage * 6000 + arrival epoch | sequence ]
+ *
+ * All heaps must treat the cases in the same order; a checksum of the
+ * treated handles is printed to show that.
+ *
+ * Usage: dary_heap_benchmark [maxOps]   (default 10,000,000)
+ */
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Heap>
+static void run(const char *name, int ops)
+{
+    Heap heap;
+    unsigned seed = 2024;
+    uint32_t epoch = 1763380800u;
+    uint32_t sequence = 0;
+    
+    // Handles are recycled like payload slots
+    int *freeHandles = new int[ops + 1];
+    int freeCount = 0;
+    int nextHandle = 0;
+    
+    uint64_t checksum = 0;
+    Clock::time_point start = Clock::now();
+    
+    for (int i = 0; i < ops; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        unsigned r = seed >> 8;
+        
+        bool arrival = (i < ops / 2) ? (r % 3 != 0) : (r % 3 == 0);
+        if (arrival || heap.isEmpty())
+        {
+            int h = freeCount > 0 ? freeHandles[--freeCount] : nextHandle++;
+            int level = 1 + (r >> 4) % 5;
+            epoch += 1 + (r >> 8) % 20;
+            uint64_t priorityKey = level * 6000u + epoch;
+            heap.push((priorityKey << 32) | sequence++, h, level);
+        }
+        else
+        {
+            int h = heap.top();
+            checksum = checksum * 31 + h;
+            heap.pop();
+            freeHandles[freeCount++] = h;
+        }
+    }
+    
+    Clock::time_point end = Clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    
+    std::cout << std::left << std::setw(10) << name
+              << std::setw(12) << ops
+              << std::setw(12) << std::fixed << std::setprecision(1) << ns / ops
+              << std::hex << checksum << std::dec << std::endl;
+    
+    delete[] freeHandles;
+}
+
+int main(int argc, char *argv[])
+{
+    int maxOps = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    
+    std::cout << std::left << std::setw(10) << "heap"
+              << std::setw(12) << "ops"
+              << std::setw(12) << "ns/op"
+              << "checksum" << std::endl;
+    
+    for (int ops = 10000; ops <= maxOps; ops *= 10)
+    {
+        run<IndexedHeap>("binary", ops);
+        run<IndexedDaryHeap<2> >("2-ary", ops);
+        run<IndexedDaryHeap<4> >("4-ary", ops);
+        run<IndexedDaryHeap<8> >("8-ary", ops);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,194 @@
+#include "core_library/emergency_department/priority_queue.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/*
+ * HEAP LAYOUT MICROBENCHMARK
+ *
+ * Compares two ways of sifting the triage heap:
+ * - record: the heap array holds whole EmergencyCase records and
+ *           every swap copies a record three times (old layout)
+ * - packed: PriorityQueue, the heap holds { 64-bit key, handle }
+ *           entries and each case is copied once in and once out
+ *           (counted by PriorityQueue::getCaseCopies)
+ *
+ * Reports ns per operation and EmergencyCase / std::string copies
+ * per operation (bytes copied per case copy: sizeof(EmergencyCase)
+ * plus the string contents).
+ *
+ * Usage: heap_layout_benchmark [record|packed|both] [cases]
+ *
+ * For cache misses, run one layout at a time under perf, e.g.
+ *   perf stat -e cache-misses,cache-references ./heap_layout_benchmark record
+ *   perf stat -e cache-misses,cache-references ./heap_layout_benchmark packed
+ */
+
+using Clock = std::chrono::steady_clock;
+
+static const int STRINGS_PER_CASE = 5;  // caseID, name, symptoms, time, date
+
+// Old layout: records in the heap, swap-based recursive sifting
+class RecordHeap
+{
+private:
+    EmergencyCase *heap;
+    int size;
+
+    void swap(int i, int j)
+    {
+        EmergencyCase temp = heap[i];
+        heap[i] = heap[j];
+        heap[j] = temp;
+        copies += 3;
+    }
+
+    void heapifyUp(int index)
+    {
+        if (index == 0)
+            return;
+        int parentIndex = (index - 1) / 2;
+        if (heap[index] < heap[parentIndex])
+        {
+            swap(index, parentIndex);
+            heapifyUp(parentIndex);
+        }
+    }
+
+    void heapifyDown(int index)
+    {
+        int left = 2 * index + 1;
+        int right = 2 * index + 2;
+        int highest = index;
+        if (left < size && heap[left] < heap[highest])
+            highest = left;
+        if (right < size && heap[right] < heap[highest])
+            highest = right;
+        if (highest != index)
+        {
+            swap(index, highest);
+            heapifyDown(highest);
+        }
+    }
+
+public:
+    long long copies;
+
+    RecordHeap(int capacity) : heap(new EmergencyCase[capacity]), size(0), copies(0) {}
+    ~RecordHeap() { delete[] heap; }
+
+    bool isEmpty() const { return size == 0; }
+
+    void enqueue(const EmergencyCase &emergencyCase)
+    {
+        heap[size] = emergencyCase;
+        copies++;
+        heapifyUp(size);
+        size++;
+    }
+
+    void dequeue(EmergencyCase &emergencyCase)
+    {
+        emergencyCase = heap[0];
+        heap[0] = heap[size - 1];
+        copies += 2;
+        size--;
+        if (size > 0)
+            heapifyDown(0);
+    }
+};
+
+static EmergencyCase *makeCases(int n)
+{
+    EmergencyCase *cases = new EmergencyCase[n];
+    std::srand(7);
+
+    for (int i = 0; i < n; i++)
+    {
+        cases[i].caseID = "EC" + std::to_string(1000000 + i);
+        cases[i].patientName = "Benchmark Patient Number " + std::to_string(i);
+        cases[i].emergencyType = static_cast<EmergencyType>(std::rand() % 3);
+        cases[i].triageLevel = static_cast<TriageLevel>(1 + std::rand() % 5);
+        cases[i].symptoms = "Chest pain radiating to the left arm, shortness of breath";
+        cases[i].arrivalTime = "12:00:00";
+        cases[i].arrivalDate = "2025-11-17";
+        cases[i].arrivalEpoch = 1763380800 + std::rand() % 86400;
+    }
+
+    return cases;
+}
+
+static void report(const char *name, double ns, double copiesPerOp)
+{
+    std::cout << std::left << std::setw(10) << name
+              << std::setw(14) << std::fixed << std::setprecision(1) << ns
+              << std::setw(16) << std::setprecision(2) << copiesPerOp
+              << std::setw(16) << copiesPerOp * STRINGS_PER_CASE << std::endl;
+}
+
+static void runRecord(const EmergencyCase *cases, int n)
+{
+    RecordHeap heap(n);
+    EmergencyCase out;
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < n; i++)
+        heap.enqueue(cases[i]);
+    while (!heap.isEmpty())
+        heap.dequeue(out);
+    Clock::time_point end = Clock::now();
+
+    double ops = 2.0 * n;
+    double copiesPerOp = heap.copies / ops;
+    report("record",
+           std::chrono::duration<double, std::nano>(end - start).count() / ops,
+           copiesPerOp);
+}
+
+static void runPacked(const EmergencyCase *cases, int n)
+{
+    PriorityQueue queue;
+    queue.reserve(n);
+    EmergencyCase out;
+    long long copiesBefore = PriorityQueue::getCaseCopies();
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < n; i++)
+        queue.enqueue(cases[i]);
+    while (!queue.isEmpty())
+        queue.dequeue(out);
+    Clock::time_point end = Clock::now();
+
+    // Counted by the queue itself (sifting only moves heap entries)
+    double ops = 2.0 * n;
+    double copiesPerOp = (PriorityQueue::getCaseCopies() - copiesBefore) / ops;
+    report("packed",
+           std::chrono::duration<double, std::nano>(end - start).count() / ops,
+           copiesPerOp);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *mode = argc > 1 ? argv[1] : "both";
+    int n = argc > 2 ? std::atoi(argv[2]) : 200000;
+
+    EmergencyCase *cases = makeCases(n);
+
+    std::cout << "cases: " << n << ", sizeof(EmergencyCase): " << sizeof(EmergencyCase)
+              << " bytes" << std::endl;
+    std::cout << std::left << std::setw(10) << "layout"
+              << std::setw(14) << "ns/op"
+              << std::setw(16) << "case copies/op"
+              << std::setw(16) << "str copies/op" << std::endl;
+
+    if (std::strcmp(mode, "packed") != 0)
+        runRecord(cases, n);
+    if (std::strcmp(mode, "record") != 0)
+        runPacked(cases, n);
+
+    delete[] cases;
+    return 0;
+}
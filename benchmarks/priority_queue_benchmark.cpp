@@ -0,0 +1,104 @@
+#include "core_library/emergency_department/priority_queue.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+/*
+ * PRIORITY QUEUE BENCHMARK
+ *
+ * Enqueues n synthetic cases, then dequeues all of them, for
+ * n = 1e2 ... 1e6, and reports the average cost per operation.
+ * With the queue full it also times one "next 20 cases" page
+ * (getTopCases), which should stay flat as n grows.
+ *
+ * Usage: priority_queue_benchmark [maxCases]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+static EmergencyCase *makeCases(int n)
+{
+    EmergencyCase *cases = new EmergencyCase[n];
+    std::srand(42);
+
+    for (int i = 0; i < n; i++)
+    {
+        std::stringstream id;
+        id << "EC" << std::setfill('0') << std::setw(7) << i;
+
+        int seconds = std::rand() % 86400;
+        std::stringstream arrival;
+        arrival << std::setfill('0') << std::setw(2) << seconds / 3600 << ":"
+                << std::setfill('0') << std::setw(2) << (seconds / 60) % 60 << ":"
+                << std::setfill('0') << std::setw(2) << seconds % 60;
+
+        cases[i].caseID = id.str();
+        cases[i].patientName = "Patient " + std::to_string(i);
+        cases[i].emergencyType = static_cast<EmergencyType>(std::rand() % 3);
+        cases[i].triageLevel = static_cast<TriageLevel>(1 + std::rand() % 5);
+        cases[i].symptoms = "Synthetic benchmark case";
+        cases[i].arrivalTime = arrival.str();
+        cases[i].arrivalDate = "2025-11-17";
+        cases[i].arrivalEpoch = parseArrivalEpoch(cases[i].arrivalTime, cases[i].arrivalDate);
+    }
+
+    return cases;
+}
+
+static double nsPerOp(Clock::time_point start, Clock::time_point end, int ops)
+{
+    return std::chrono::duration<double, std::nano>(end - start).count() / ops;
+}
+
+int main(int argc, char *argv[])
+{
+    int maxCases = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    std::cout << std::left << std::setw(12) << "cases"
+              << std::setw(18) << "enqueue ns/op"
+              << std::setw(18) << "dequeue ns/op"
+              << std::setw(14) << "top-20 us"
+              << std::setw(12) << "capacity" << std::endl;
+
+    for (int n = 100; n <= maxCases; n *= 10)
+    {
+        EmergencyCase *cases = makeCases(n);
+        PriorityQueue queue;
+
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < n; i++)
+        {
+            queue.enqueue(cases[i]);
+        }
+        Clock::time_point mid = Clock::now();
+
+        int capacity = queue.getCapacity();
+
+        EmergencyCase page[20];
+        Clock::time_point pageStart = Clock::now();
+        queue.getTopCases(page, 20);
+        Clock::time_point pageEnd = Clock::now();
+        double pageMicros = std::chrono::duration<double, std::micro>(pageEnd - pageStart).count();
+
+        EmergencyCase out;
+        while (!queue.isEmpty())
+        {
+            queue.dequeue(out);
+        }
+        Clock::time_point end = Clock::now();
+
+        std::cout << std::left << std::setw(12) << n
+                  << std::setw(18) << std::fixed << std::setprecision(1) << nsPerOp(start, mid, n)
+                  << std::setw(18) << nsPerOp(mid, end, n)
+                  << std::setw(14) << pageMicros
+                  << std::setw(12) << capacity << std::endl;
+
+        queue.shrinkToFit(true);
+        delete[] cases;
+    }
+
+    return 0;
+}
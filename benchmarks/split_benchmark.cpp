@@ -0,0 +1,197 @@
+#include "core_library/utils.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+/*
+ * FIELD SPLITTER BENCHMARK
+ *
+ * Splits every line of a multi-MB comma-separated buffer with:
+ * - find+substr: the old splitStringToArr loop (a std::string per field)
+ * - scalar:      Utils::splitStringToViews reference, one byte per step
+ * - simd:        Utils::splitStringToViews (SSE2, or AVX2 when compiled
+ *                with -mavx2 / -march=native)
+ *
+ * Input: the file given on the command line, or two synthetic shapes:
+ * - narrow: case-file lines, 8 short fields
+ * - wide:   100-field lines like the ones readLineFromFile scans
+ *
+ * The checksum (sum of field lengths and counts) must be the same for
+ * all three splitters.
+ *
+ * Usage: split_benchmark [file]   (default: 32 MB of each synthetic shape)
+ */
+
+using Clock = std::chrono::steady_clock;
+
+static const int MAX_FIELDS = 128;
+
+// The splitter as it was: find + substr, one allocation per field
+static int splitFindSubstr(std::string *arr, int arrUpperLimit, const std::string &s, char delimiter)
+{
+    int arrPos = 0;
+    size_t start = 0;
+    size_t pos = 0;
+
+    while ((pos = s.find(delimiter, start)) != std::string::npos && arrPos < arrUpperLimit)
+    {
+        arr[arrPos++] = s.substr(start, pos - start);
+        start = pos + 1;
+    }
+    if (arrPos < arrUpperLimit)
+        arr[arrPos++] = s.substr(start);
+
+    return arrPos;
+}
+
+// Lines of `text` as views (the text must end with '\n')
+static std::string_view *splitLines(const std::string &text, int &lineCount)
+{
+    lineCount = 0;
+    for (char c : text)
+        lineCount += c == '\n';
+
+    std::string_view *lines = new std::string_view[lineCount];
+    size_t start = 0;
+    for (int i = 0; i < lineCount; i++)
+    {
+        size_t end = text.find('\n', start);
+        lines[i] = std::string_view(text).substr(start, end - start);
+        start = end + 1;
+    }
+    return lines;
+}
+
+static void report(const char *input, const char *name, double seconds, size_t bytes, uint64_t checksum)
+{
+    std::cout << std::left << std::setw(10) << input
+              << std::setw(14) << name
+              << std::setw(12) << std::fixed << std::setprecision(1) << bytes / 1048576.0 / seconds
+              << std::hex << checksum << std::dec << std::endl;
+}
+
+static void run(const char *input, const std::string &text)
+{
+    int lineCount = 0;
+    std::string_view *lines = splitLines(text, lineCount);
+    std::string_view views[MAX_FIELDS];
+    std::string *strings = new std::string[MAX_FIELDS];
+
+    // find + substr (each line copied into a std::string first, as
+    // getline would)
+    {
+        uint64_t checksum = 0;
+        std::string line;
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < lineCount; i++)
+        {
+            line.assign(lines[i].data(), lines[i].size());
+            int count = splitFindSubstr(strings, MAX_FIELDS, line, ',');
+            checksum += count;
+            for (int f = 0; f < count; f++)
+                checksum += strings[f].size();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        report(input, "find+substr", seconds, text.size(), checksum);
+    }
+
+    // Scalar views
+    {
+        uint64_t checksum = 0;
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < lineCount; i++)
+        {
+            int count = Utils::splitStringToViewsScalar(views, MAX_FIELDS, lines[i], ',');
+            checksum += count;
+            for (int f = 0; f < count; f++)
+                checksum += views[f].size();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        report(input, "scalar", seconds, text.size(), checksum);
+    }
+
+    // SIMD views
+    {
+        uint64_t checksum = 0;
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < lineCount; i++)
+        {
+            int count = Utils::splitStringToViews(views, MAX_FIELDS, lines[i], ',');
+            checksum += count;
+            for (int f = 0; f < count; f++)
+                checksum += views[f].size();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        report(input, "simd", seconds, text.size(), checksum);
+    }
+
+    delete[] strings;
+    delete[] lines;
+}
+
+// Synthetic file of about `bytes` bytes, `fields` fields per line
+static std::string makeText(size_t bytes, int fields)
+{
+    static const char *const words[] = { "EC0042", "Jane Doe", "2", "1", "Chest pain",
+                                         "10:15:00", "2026-10-17", "35", "AMB007", "On Duty" };
+    std::string text;
+    text.reserve(bytes + 4096);
+    unsigned seed = 2024;
+
+    while (text.size() < bytes)
+    {
+        for (int f = 0; f < fields; f++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            if (f > 0)
+                text += ',';
+            text += words[(seed >> 8) % 10];
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+int main(int argc, char *argv[])
+{
+#if defined(__AVX2__)
+    const char *path = "AVX2";
+#elif defined(UTILS_SPLIT_SSE2)
+    const char *path = "SSE2";
+#else
+    const char *path = "scalar only";
+#endif
+    std::cout << "simd path: " << path << "\n\n";
+
+    std::cout << std::left << std::setw(10) << "input"
+              << std::setw(14) << "splitter"
+              << std::setw(12) << "MB/s"
+              << "checksum" << std::endl;
+
+    if (argc > 1)
+    {
+        std::ifstream file(argv[1], std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "cannot open " << argv[1] << std::endl;
+            return 1;
+        }
+        std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (text.empty() || text[text.size() - 1] != '\n')
+            text += '\n';
+        run("file", text);
+        return 0;
+    }
+
+    const size_t bytes = 32u * 1024 * 1024;
+    run("narrow", makeText(bytes, 8));
+    run("wide", makeText(bytes, 100));
+
+    return 0;
+}
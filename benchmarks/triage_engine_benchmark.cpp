@@ -0,0 +1,159 @@
+#include "core_library/emergency_department/indexed_heap.hpp"
+#include "core_library/emergency_department/triage_buckets.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+/*
+ * TRIAGE ENGINE BENCHMARK
+ *
+ * Runs the same operation trace through both ordering engines of the
+ * triage queue:
+ * - heap:   IndexedHeap (binary heap, O(log n))
+ * - bucket: TriageBuckets (one FIFO ring per level, O(1))
+ *
+ * Trace (steady state with `waiting` cases in the queue):
+ * - each step one patient arrives (random level, clock moves forward)
+ *   and the top case is treated
+ * - every 16th step a random waiting case is re-triaged, every 32nd
+ *   step one is cancelled (and a replacement arrives)
+ * Keys are built like PriorityQueue does:
+ *   [ triage * 6000 + arrival epoch | sequence ]
+ *
+ * Both engines must treat the cases in the same order; a checksum of
+ * the treated handles is printed to show that.
+ *
+ * Usage: triage_engine_benchmark [steps]
+ */
+
+using Clock = std::chrono::steady_clock;
+
+static const uint32_t BASE_EPOCH = 1763380800u;
+
+struct Trace
+{
+    uint32_t epoch;
+    uint32_t sequence;
+    unsigned seed;
+
+    Trace() : epoch(BASE_EPOCH), sequence(0), seed(12345) {}
+
+    unsigned next()
+    {
+        seed = seed * 1103515245u + 12345u;
+        return seed >> 8;
+    }
+
+    int nextLevel() { return 1 + next() % 5; }
+
+    uint64_t makeKey(int level, uint32_t arrival)
+    {
+        uint32_t priorityKey = level * 6000u + arrival;
+        return (static_cast<uint64_t>(priorityKey) << 32) | sequence++;
+    }
+};
+
+template <typename Engine>
+static void run(const char *name, int waiting, int steps)
+{
+    Engine engine;
+    Trace trace;
+    engine.reserve(waiting + 1);
+    engine.reserveHandles(waiting + 1);
+
+    // Handles 0..waiting are recycled like payload slots
+    int *freeHandles = new int[waiting + 1];
+    int *arrival = new int[waiting + 1];
+    int freeCount = 0;
+    for (int h = waiting; h >= 0; h--)
+        freeHandles[freeCount++] = h;
+
+    for (int i = 0; i < waiting; i++)
+    {
+        int h = freeHandles[--freeCount];
+        int level = trace.nextLevel();
+        arrival[h] = trace.epoch;
+        engine.push(trace.makeKey(level, trace.epoch), h, level);
+        trace.epoch += 1 + trace.next() % 20;
+    }
+
+    uint64_t checksum = 0;
+    long long ops = 0;
+    Clock::time_point start = Clock::now();
+
+    for (int s = 0; s < steps; s++)
+    {
+        // Arrival
+        int h = freeHandles[--freeCount];
+        int level = trace.nextLevel();
+        arrival[h] = trace.epoch;
+        engine.push(trace.makeKey(level, trace.epoch), h, level);
+        trace.epoch += 1 + trace.next() % 20;
+
+        // Re-triage a random waiting case (keeps its sequence)
+        if (s % 16 == 0)
+        {
+            int target = trace.next() % (waiting + 1);
+            if (engine.contains(target))
+            {
+                int newLevel = trace.nextLevel();
+                uint64_t sequence = engine.keyOf(target) & 0xFFFFFFFFu;
+                uint64_t priorityKey = newLevel * 6000u + arrival[target];
+                engine.changeKey(target, (priorityKey << 32) | sequence, newLevel);
+                ops++;
+            }
+        }
+
+        // Cancel a random waiting case, or treat the top case
+        int removed = -1;
+        if (s % 32 == 0)
+        {
+            int target = trace.next() % (waiting + 1);
+            if (engine.contains(target))
+            {
+                engine.erase(target);
+                removed = target;
+            }
+        }
+        if (removed < 0)
+        {
+            removed = engine.top();
+            checksum = checksum * 31 + removed;
+            engine.pop();
+        }
+        freeHandles[freeCount++] = removed;
+        ops += 2;
+    }
+
+    Clock::time_point end = Clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::cout << std::left << std::setw(10) << name
+              << std::setw(12) << waiting
+              << std::setw(12) << std::fixed << std::setprecision(1) << ns / ops
+              << std::hex << checksum << std::dec << std::endl;
+
+    delete[] freeHandles;
+    delete[] arrival;
+}
+
+int main(int argc, char *argv[])
+{
+    int steps = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    std::cout << "steps: " << steps << std::endl;
+    std::cout << std::left << std::setw(10) << "engine"
+              << std::setw(12) << "waiting"
+              << std::setw(12) << "ns/op"
+              << "checksum" << std::endl;
+
+    for (int waiting = 100; waiting <= 1000000; waiting *= 10)
+    {
+        run<IndexedHeap>("heap", waiting, steps);
+        run<TriageBuckets>("bucket", waiting, steps);
+    }
+
+    return 0;
+}
@@ -1,8 +1,15 @@
 #pragma once
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include "utils.hpp"
+#include "key_index.hpp"
 #include <iostream>
 
 struct FileIO
@@ -43,80 +50,119 @@ struct FileIO
     return count; // number of lines read
   }
 
-  // NOTE: SPECIFICALLY TO READ INDEX.TXT FILE ONLY CAUSE IM LAZY, DO NOT USE FOR OTHERS
-  static int getFileCount(std::string targetFile)
-  {
-    std::string lines[3];
-    std::string line;
-    std::ifstream in("../core_library/include/data/index.txt");
-    if (!in.is_open())
-      return -1;
+  /*
+   * COUNTED RECORD FILES
+   *
+   * The record count lives in a fixed-width first line of the data file
+   * itself, so it can be rewritten in place:
+   *
+   *   #count,0000000007
+   *   SI1,bandage,20,BT1
+   *   ...
+   *
+   * - appendRecordsToFile: append the lines, rewrite the header
+   * - popRecordFromFile: read backward from the end to the start of the
+   *   last line, truncate the file there, rewrite the header
+   * - A file in the old layout (no header) gets one on first use
+   *
+   * Time Complexity:
+   * - getRecordCount: O(1) (one O(file) rewrite for an old-layout file)
+   * - appendRecordsToFile: O(appended bytes)
+   * - popRecordFromFile: O(length of the last line)
+   */
+  static const int COUNT_HEADER_SIZE = 18; // "#count," + 10 digits + '\n'
 
-    while (std::getline(in, line))
-    {
-      int count = Utils::splitStringToArr(lines, 3, line, ",");
-      if (lines[0] == targetFile)
-      {
-        return std::stoi(lines[1]);
-      }
-    }
-    return -1;
+  // Is this the count line of a counted file? (loaders skip it)
+  static bool isCountHeader(std::string_view line)
+  {
+    if (!line.empty() && line.back() == '\r')
+      line.remove_suffix(1);
+    return line.size() == COUNT_HEADER_SIZE - 1 && line.substr(0, 7) == "#count,";
   }
 
-  // NOTE: THIS IS ALSO SPECIFICALLY FOR INDEX TEXT FILE
-  static void updateFileCount(std::string targetFile, int newCount)
+  // Records in a counted file (-1 = cannot be opened or created). A
+  // missing file is created empty; an old-layout file gets its header
+  static int getRecordCount(const std::string &filename)
   {
-    std::ifstream in("../core_library/include/data/index.txt");
-    if (!in.is_open())
-      return;
-
-    std::ofstream temp("../core_library/include/data/index_tmp.txt");
-    if (!temp.is_open())
+    std::ifstream in(filename, std::ios::binary);
+    if (in.is_open())
     {
+      int count = 0;
+      if (readCountHeader(in, count))
+        return count;
       in.close();
-      return;
     }
+    return addCountHeader(filename);
+  }
 
-    std::string line;
-    std::string parts[3];
-
-    while (std::getline(in, line))
-    {
-      int count = Utils::splitStringToArr(parts, 3, line, ",");
+  // Append `count` objects (one toString() line each) to a counted file
+  // NOTE: YOUR CLASS REQUIRES A toString() METHOD FOR IT TO WORK
+  template <typename T>
+  static bool appendRecordsToFile(const std::string &filename, T *objectArr, int count)
+  {
+    int records = getRecordCount(filename);
+    if (records < 0)
+      return false;
 
-      if (parts[0] == targetFile)
-      {
-        temp << parts[0] << "," << newCount << "\n";
-      }
-      else
-      {
-        temp << line << "\n";
-      }
-    }
+    appendObjectsToFile(filename, objectArr, count);
+    return writeCountHeader(filename, records + count);
+  }
 
-    in.close();
-    temp.close();
+  // Drop the last record of a counted file (false = empty or unreadable);
+  // `popped` gets the removed line
+  static bool popRecordFromFile(const std::string &filename, std::string *popped = nullptr)
+  {
+    int records = getRecordCount(filename);
+    if (records <= 0)
+      return false;
 
-    // Replace the original file with the updated one
-    std::remove("../core_library/include/data/index.txt");
-    std::rename("../core_library/include/data/index_tmp.txt", "../core_library/include/data/index.txt");
+    // The header is only lowered once the line is gone: a crash in
+    // between leaves a count that is one too high, never a reused id
+    if (!truncateLastLine(filename, COUNT_HEADER_SIZE, popped))
+      return false;
+    return writeCountHeader(filename, records - 1);
   }
 
   // NOTE: TO FIND A ROW FROM VALUE X OF INDEX Y
+  // Looked up through the file's sidecar key index for that column (built
+  // on first use, kept up to date with the file); the full scan is only
+  // the fallback when the index cannot be written
   static std::string readLineFromFile(const std::string &filename, std::string targetValue, int targetIndex = 0)
+  {
+    std::string found;
+    if (KeyIndex::find(filename, targetValue, targetIndex, found) < 0)
+      return scanLineFromFile(filename, targetValue, targetIndex);
+
+    return found;
+  }
+
+  // Several lookups on one column in one pass: lines[i] gets the row of
+  // targetValues[i] or "" (returns how many were found)
+  static int readLinesFromFile(const std::string &filename, const std::string *targetValues, int count,
+                               std::string *lines, int targetIndex = 0)
+  {
+    return KeyIndex::findMany(filename, targetValues, count, targetIndex, lines);
+  }
+
+  // Front-to-back scan for the row (no index)
+  static std::string scanLineFromFile(const std::string &filename, const std::string &targetValue, int targetIndex = 0)
   {
     const int arrUpperLimit = 100;
-    std::string lines[arrUpperLimit];
+    std::string_view fields[arrUpperLimit];
     std::string line;
 
+    if (targetIndex < 0 || targetIndex >= arrUpperLimit)
+      return "";
+
     std::ifstream in(filename);
     if (!in.is_open())
       return "";
 
+    // Only the fields up to the target column are split out
     while (std::getline(in, line))
     {
-      int count = Utils::splitStringToArr(lines, arrUpperLimit, line, ",");
-      if (targetIndex < count && lines[targetIndex] == targetValue)
+      int count = Utils::splitStringToViews(fields, targetIndex + 1, line, ',');
+      if (targetIndex < count && fields[targetIndex] == targetValue)
       {
         return line;
       }
@@ -141,49 +187,141 @@ struct FileIO
     outFile.close();
   }
 
+  // Remove the last line of any text file by truncating it (the file is
+  // never copied; only the last line is read, backward from the end)
   static void removeLastLineFromFile(const std::string &filename)
   {
-    std::ifstream inFile(filename);
-    if (!inFile.is_open())
+    if (!truncateLastLine(filename, 0, nullptr))
     {
-      std::cerr << "Error: Could not open file for reading: " << filename << std::endl;
-      return;
+      std::cerr << "Error: Could not remove the last line of: " << filename << std::endl;
     }
+  }
 
-    std::ofstream tempFile("temp_file.tmp");
-    if (!tempFile.is_open())
-    {
-      std::cerr << "Error: Could not create temporary file.\n";
-      return;
-    }
+private:
+  // Cut the last non-empty line at or after byte `begin` off the file
+  // (trailing blank lines go with it); `removed` gets its text
+  static bool truncateLastLine(const std::string &filename, std::streamoff begin, std::string *removed)
+  {
+    const int BLOCK_SIZE = 256;
+    char block[BLOCK_SIZE];
 
-    std::string line;
-    std::string prevLine;
-    bool firstLine = true;
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    if (!in.is_open())
+      return false;
+    std::streamoff size = in.tellg();
 
-    while (std::getline(inFile, line))
+    // Walk back block by block: first past the trailing line breaks to the
+    // end of the last line, then to the '\n' before it
+    std::streamoff lineEnd = -1;
+    std::streamoff lineStart = -1;
+    std::streamoff position = size;
+    while (position > begin && lineStart < 0)
     {
-      if (!firstLine)
+      std::streamoff blockStart = position - BLOCK_SIZE > begin ? position - BLOCK_SIZE : begin;
+      int length = static_cast<int>(position - blockStart);
+      in.seekg(blockStart);
+      if (!in.read(block, length))
+        return false;
+
+      for (int i = length - 1; i >= 0 && lineStart < 0; --i)
       {
-        tempFile << prevLine << '\n';
+        if (lineEnd < 0)
+        {
+          if (block[i] != '\n' && block[i] != '\r')
+            lineEnd = blockStart + i + 1;
+        }
+        else if (block[i] == '\n')
+          lineStart = blockStart + i + 1;
       }
-      prevLine = line;
-      firstLine = false;
+      position = blockStart;
     }
 
-    inFile.close();
-    tempFile.close();
+    if (lineEnd < 0)
+      return false;
+    if (lineStart < 0)
+      lineStart = begin;
 
-    if (std::remove(filename.c_str()) != 0)
+    if (removed != nullptr)
     {
-      std::cerr << "Error: Could not remove original file.\n";
-      return;
+      removed->resize(static_cast<size_t>(lineEnd - lineStart));
+      in.clear();
+      in.seekg(lineStart);
+      in.read(&(*removed)[0], lineEnd - lineStart);
+    }
+    in.close();
+
+    std::error_code error;
+    std::filesystem::resize_file(filename, static_cast<std::uintmax_t>(lineStart), error);
+    return !error;
+  }
+
+  // Parse the count line at the start of `in`
+  static bool readCountHeader(std::istream &in, int &count)
+  {
+    char header[COUNT_HEADER_SIZE];
+    if (!in.read(header, COUNT_HEADER_SIZE) || header[COUNT_HEADER_SIZE - 1] != '\n' ||
+        !isCountHeader(std::string_view(header, COUNT_HEADER_SIZE - 1)))
+      return false;
+
+    const char *digits = header + 7;
+    const char *end = header + COUNT_HEADER_SIZE - 1;
+    std::from_chars_result result = std::from_chars(digits, end, count);
+    return result.ec == std::errc() && result.ptr == end && count >= 0;
+  }
+
+  // Overwrite the count line in place (same width, nothing else moves)
+  static bool writeCountHeader(const std::string &filename, int count)
+  {
+    char header[COUNT_HEADER_SIZE + 1];
+    std::snprintf(header, sizeof(header), "#count,%010d\n", count);
+
+    std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.is_open())
+      return false;
+    file.seekp(0);
+    file.write(header, COUNT_HEADER_SIZE);
+    return static_cast<bool>(file);
+  }
+
+  // Give an old-layout (or missing) file its count line: the lines are
+  // counted and the file rewritten once through a temporary file
+  static int addCountHeader(const std::string &filename)
+  {
+    std::string content;
+    std::ifstream in(filename, std::ios::binary);
+    if (in.is_open())
+    {
+      content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+      in.close();
     }
-    if (std::rename("temp_file.tmp", filename.c_str()) != 0)
+    if (!content.empty() && content.back() != '\n')
+      content += '\n';
+
+    int count = 0;
+    size_t start = 0;
+    while (start < content.size())
     {
-      std::cerr << "Error: Could not rename temp file.\n";
-      return;
+      size_t end = content.find('\n', start);
+      if (end > start && !(end == start + 1 && content[start] == '\r'))
+        count++;
+      start = end + 1;
     }
-  }
 
+    char header[COUNT_HEADER_SIZE + 1];
+    std::snprintf(header, sizeof(header), "#count,%010d\n", count);
+
+    std::string temporary = filename + ".tmp";
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+      return -1;
+    out.write(header, COUNT_HEADER_SIZE);
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+    out.close();
+    if (!out)
+      return -1;
+
+    std::error_code error;
+    std::filesystem::rename(temporary, filename, error);
+    return error ? -1 : count;
+  }
 };
@@ -2,28 +2,52 @@
 #define AMBULANCE_HPP
 
 #include <string>
+#include <string_view>
 #include <ctime>
 using namespace std;
 
+// Duty state of an ambulance (one byte in the record; the text only
+// appears on screen and in the data file)
+enum class AmbulanceStatus : unsigned char
+{
+  OnDuty,
+  Standby,
+  OffDuty
+};
+
+/*
+ * The schedule is kept as integers (schedule minutes, see
+ * toScheduleMinute): comparing shifts is one integer compare, and the
+ * "YYYY-MM-DD" / "HH:MM" text is formatted only when a shift is shown
+ * or saved
+ */
 struct Ambulance
 {
   string vehicleID;
   string ambulanceID;
   string driverName;
-  string status;
-  string scheduleDate;
-  string shiftStartTime;
-  string shiftEndTime;
+
+  long long shiftStart;    // Start of the next/current shift (-1 = not scheduled)
+  int shiftMinutes;        // Length of this ambulance's shift in minutes
+
+  // Place in the rotation (kept by ShiftRoster, which writes shiftStart
+  // from it when the ambulance is shown or saved)
+  int shiftOffset;         // Minutes from the start of a rotation cycle to this shift
+
+  AmbulanceStatus status;
 
   // Constructor
   Ambulance() : vehicleID(""), ambulanceID(""), driverName(""),
-                status("Standby"), scheduleDate("--"), shiftStartTime("--:--"), shiftEndTime("--:--") {}
+                shiftStart(-1), shiftMinutes(0), shiftOffset(0), status(AmbulanceStatus::Standby) {}
 
   // Parameterized constructor
-  Ambulance(string vID, string aID, string driver, string stat = "Standby", string date = "--",
-            string startTime = "--:--", string endTime = "--:--")
+  Ambulance(string vID, string aID, string driver, AmbulanceStatus stat = AmbulanceStatus::Standby,
+            long long start = -1, int minutes = 0)
       : vehicleID(vID), ambulanceID(aID), driverName(driver),
-        status(stat), scheduleDate(date), shiftStartTime(startTime), shiftEndTime(endTime) {}
+        shiftStart(start), shiftMinutes(minutes), shiftOffset(0), status(stat) {}
+
+  // End of the shift (-1 = not scheduled)
+  long long shiftEnd() const { return shiftStart < 0 ? -1 : shiftStart + shiftMinutes; }
 
   void display() const;
 
@@ -31,7 +55,7 @@ struct Ambulance
 
   bool isShiftActive() const;
 
-  void generateShiftTimes(string startTime, int durationHours);
+  void generateShiftTimes(long long start, int durationHours);
 };
 
 // Helper functions
@@ -41,10 +65,25 @@ string getCurrentDateString();
 
 string getDayOfWeek();
 
-string addHoursToTime(string timeStr, int hours);
+// Schedule minutes: minutes since 1970-01-01 00:00 of a wall-clock date
+// and time (no time zone, every day is 1440 minutes)
+long long toScheduleMinute(string_view date, string_view time); // -1 = unset or malformed
+
+long long parseScheduleDate(string_view date); // "YYYY-MM-DD" -> minute of its 00:00 (-1 = malformed)
+
+int parseClockTime(string_view time); // "HH:MM" -> minutes into the day (-1 = malformed)
+
+void formatScheduleMinute(long long minute, string &date, string &time);
+
+string formatScheduleDate(long long minute); // "YYYY-MM-DD" ("--" for -1)
+
+string formatScheduleTime(long long minute); // "HH:MM" ("--:--" for -1)
+
+long long currentScheduleMinute();
 
-void addHoursToDateTime(string& date, string& time, int hours);
+// Status text ("On Duty", "Standby", "Off Duty") and back
+const char *statusName(AmbulanceStatus status);
 
-int calculateTimeDifference(string startTime, string endTime);
+AmbulanceStatus parseStatus(string_view text); // Unknown text = Off Duty
 
 #endif
\ No newline at end of file
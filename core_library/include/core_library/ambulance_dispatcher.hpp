@@ -2,6 +2,7 @@
 #define AMBULANCEDISPATCHER_HPP
 
 #include "circular_queue.hpp"
+#include "shift_roster.hpp"
 #include "ambulance.hpp"
 #include <string>
 using namespace std;
@@ -20,6 +21,7 @@ class AmbulanceDispatcher
 {
 private:
     CircularQueue ambulanceQueue;
+    ShiftRoster roster;           // Everyone's shift, derived from the rotation order
     int nextAmbulanceNumber;      // Auto-increment counter for ambulance IDs
     int shiftDurationHours;       // Standard shift duration (default: 8 hours)
 
@@ -44,10 +46,10 @@ public:
 
     void dynamicRotate();
 
-    void displayUpcomingRotation() const;
+    void displayUpcomingRotation();
 
     // Functionality 3: Display Ambulance Schedule
-    void displayAmbulanceSchedule() const;
+    void displayAmbulanceSchedule();
 
     void autoScheduleCheck();
 
@@ -55,6 +57,15 @@ public:
 
     void setShiftDuration(int hours);
 
+    // Functionality 4: Rotation Planner (who is on duty when)
+    void planRotation() const;
+
+    void displayDutyAt(long long minute) const;
+
+    void displayShiftsBetween(long long from, long long to) const;
+
+    void displayNextShiftOf(const string &vehicleID, long long minute) const;
+
     // Load ambulances from file (helper function)
     void loadAmbulancesFromFile(const string &filename);
 
@@ -3,21 +3,68 @@
 
 #include "ambulance.hpp"
 #include <iostream>
+#include <stdexcept>
+#include <utility>
 using namespace std;
 
-struct Node
-{
-    Ambulance data;
-    Node *next;
-
-    Node(Ambulance amb) : data(amb), next(nullptr) {}
-};
+/*
+ * CIRCULAR QUEUE - AMBULANCE ROTATION ON A RING BUFFER
+ *
+ * Concept: The fleet lives in one contiguous array; the rotation order
+ * is a ring of slot numbers over it and the front is an index into that
+ * ring, not a node
+ *
+ * Layout (capacity = power of two, mask = capacity - 1):
+ *   slots[capacity]             the ambulances (they stay where they are)
+ *   order[capacity]             ring of slot numbers, a permutation of
+ *                               0..capacity-1
+ *   i-th ambulance from front = slots[order[(head + i) & mask]]
+ *   order[(head + size) ...]    the free slots, after the rear
+ *
+ * - enqueue takes the free slot after the rear, dequeue hands the front
+ *   slot back by moving head on: no ambulance is shifted
+ * - rotate with a full ring is only head = (head + 1) & mask (the old
+ *   front already sits after the rear). Otherwise the front's slot
+ *   number is moved into the free position after the rear (swapped
+ *   with the free slot number there), then head moves on. Only 4-byte
+ *   slot numbers move, never an Ambulance
+ * - A full ring doubles; the ambulances are moved over in queue order
+ *   and the ring starts again as 0, 1, 2, ... (head = 0)
+ * - front() / rear() / at(i) return references into the array, and
+ *   modifyFront / modifyRear / modifyAt(i, fn) hand the slot to a
+ *   visitor, so callers edit an ambulance where it lives instead of
+ *   copying it out and back (getFront / updateFront)
+ * - A reference stays valid until the next enqueue or emplace that
+ *   doubles the ring (or until its ambulance is dequeued); rotate and
+ *   dequeue move no ambulance
+ *
+ * Time Complexity:
+ * - rotate, dequeue, front, rear, at, modify*, getFront, updateFront,
+ *   updateRear: O(1)
+ * - enqueue, emplace: O(1) amortised (O(n) when the ring doubles)
+ * - display, getAllAmbulances: O(n)
+ */
 
 class CircularQueue
 {
 private:
-    Node *rear;
-    int size;
+    static const int INITIAL_CAPACITY = 8;
+
+    Ambulance *slots;   // Storage (nullptr until the first enqueue)
+    int *order;         // Ring of slot numbers (see above)
+    int capacity;       // Slots allocated (0 or a power of two)
+    int head;           // Ring position of the front
+    int size;           // Ambulances in the ring
+
+    CircularQueue(const CircularQueue &);
+    CircularQueue &operator=(const CircularQueue &);
+
+    // Slot of the i-th ambulance from the front
+    int slotOf(int i) const { return order[(head + i) & (capacity - 1)]; }
+
+    void grow();
+
+    Ambulance &pushSlot();
 
 public:
     CircularQueue();
@@ -32,6 +79,16 @@ public:
     /* Operations */
     void enqueue(const Ambulance &ambulance);
 
+    void enqueue(Ambulance &&ambulance);
+
+    // Build the ambulance from constructor arguments and move it into
+    // the rear slot (no copy of its strings)
+    template <typename... Args>
+    void emplace(Args &&...args)
+    {
+        pushSlot() = Ambulance(std::forward<Args>(args)...);
+    }
+
     bool dequeue(Ambulance &ambulance);
 
     bool rotate();
@@ -46,6 +103,45 @@ public:
 
     void getAllAmbulances(Ambulance ambulances[], int &count) const;
 
+    /* In-place access (the queue must not be empty; at() checks the index) */
+    Ambulance &front();
+
+    const Ambulance &front() const;
+
+    Ambulance &rear();
+
+    const Ambulance &rear() const;
+
+    // i-th ambulance from the front (0 = on duty)
+    Ambulance &at(int index);
+
+    const Ambulance &at(int index) const;
+
+    // Run fn(ambulance) on the i-th ambulance (false = no such ambulance)
+    template <typename Fn>
+    bool modifyAt(int index, Fn fn)
+    {
+        if (index < 0 || index >= size)
+        {
+            return false;
+        }
+
+        fn(slots[slotOf(index)]);
+        return true;
+    }
+
+    template <typename Fn>
+    bool modifyFront(Fn fn)
+    {
+        return modifyAt(0, fn);
+    }
+
+    template <typename Fn>
+    bool modifyRear(Fn fn)
+    {
+        return modifyAt(size - 1, fn);
+    }
+
 };
 
-#endif
\ No newline at end of file
+#endif
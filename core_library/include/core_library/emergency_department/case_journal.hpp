@@ -0,0 +1,125 @@
+#ifndef CASE_JOURNAL_HPP
+#define CASE_JOURNAL_HPP
+
+#include "core_library/emergency_department/emergency_case.hpp"
+#include <fstream>
+#include <string>
+
+/*
+ * CASE JOURNAL - APPEND-ONLY WRITE-AHEAD LOG OF QUEUE EVENTS
+ * 
+ * Concept: Persist every change as one short line instead of rewriting
+ * the whole case file
+ * - L,<case as in the case file>   case logged
+ * - T,<caseID>                     case sent to treatment
+ * - R,<caseID>,<triage level>      case re-triaged
+ * - C,<caseID>                     case cancelled (left without being seen)
+ * 
+ * Group commit:
+ * - Records are collected in memory first
+ * - commit() writes them all with one write() and one fsync()
+ * - The owner commits once per user action (a mass-casualty intake or a
+ *   batch of treatments is one fsync), or when GROUP_LIMIT records wait
+ * 
+ * Recovery: the case file is the snapshot, the journal holds everything
+ * after it. Load the snapshot, then replay() the journal on top. A last
+ * line without its newline was cut off by a crash and is skipped.
+ * Compaction writes a new snapshot and truncate()s the journal.
+ * 
+ * Time Complexity:
+ * - Log a record: O(record length)
+ * - Commit: one write + one fsync for the whole group
+ * - Replay: O(journal length)
+ */
+
+class CaseJournal
+{
+public:
+    static const int GROUP_LIMIT = 256;  // Records per group commit at most
+    
+    // One journal line
+    struct Record
+    {
+        char type;                      // 'L', 'T', 'R' or 'C'
+        EmergencyCase emergencyCase;    // Logged case ('L')
+        std::string caseID;             // Case the record is about
+        TriageLevel triageLevel;        // New level ('R')
+    };
+
+private:
+    std::string path;       // Journal file
+    int fd;                 // Open file descriptor (-1 = closed)
+    std::string pending;    // Records waiting for the next group commit
+    int pendingCount;       // Number of records in `pending`
+    int recordCount;        // Records committed since the last truncate
+    
+    CaseJournal(const CaseJournal &);
+    CaseJournal &operator=(const CaseJournal &);
+    
+    // Add one line to the group (commits when the group is full)
+    void append(const std::string &line);
+
+public:
+    // Constructor / destructor (the destructor commits what is pending)
+    CaseJournal();
+    ~CaseJournal();
+    
+    // Open (or create) the journal for appending
+    bool open(const std::string &filename);
+    void close();
+    bool isOpen() const { return fd >= 0; }
+    
+    // Queue events (written on the next commit)
+    void logCase(const EmergencyCase &emergencyCase);
+    void logTreated(const std::string &caseID);
+    void logRetriage(const std::string &caseID, TriageLevel newLevel);
+    void logCancelled(const std::string &caseID);
+    
+    // Write and fsync every pending record at once
+    bool commit();
+    
+    // Empty the journal (after a snapshot holds its events)
+    bool truncate();
+    
+    // Records waiting / committed since the last truncate
+    int getPendingCount() const { return pendingCount; }
+    int getRecordCount() const { return recordCount; }
+    
+    // Parse one journal line (false = not a valid record)
+    static bool parseRecord(const std::string &line, Record &record);
+    
+    // Flush a closed file's data to disk
+    static bool syncFile(const std::string &filename);
+    
+    // Replace `target` by `source` (used to publish a new snapshot)
+    static bool replaceFile(const std::string &source, const std::string &target);
+    
+    // Call visit(const Record&) for every complete record of a journal
+    // file, in order (returns the number of records visited)
+    template <typename Visitor>
+    static int replay(const std::string &filename, Visitor visit)
+    {
+        std::ifstream file(filename);
+        if (!file.is_open())
+            return 0;
+        
+        int count = 0;
+        std::string line;
+        Record record;
+        while (std::getline(file, line))
+        {
+            // No newline at the end: the write was torn by a crash
+            if (file.eof())
+                break;
+            
+            if (parseRecord(line, record))
+            {
+                visit(static_cast<const Record &>(record));
+                count++;
+            }
+        }
+        return count;
+    }
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef CASE_SNAPSHOT_HPP
+#define CASE_SNAPSHOT_HPP
+
+#include "core_library/emergency_department/priority_queue.hpp"
+#include <cstdint>
+#include <string>
+
+/*
+ * CASE SNAPSHOT - VERSIONED BINARY IMAGE OF THE TRIAGE QUEUE
+ * 
+ * Concept: Store the queue the way it sits in memory, so loading is a
+ * memory map plus one pass, with no text parsing
+ * 
+ * File layout (every column starts on an 8-byte boundary):
+ * - Header: magic, version, byte-order mark, case count, next sequence,
+ *           offset of every column
+ * - sequences[n]   uint32  tie-breaking sequence number of each case
+ * - epochs[n]      int64   arrival epoch (seconds)
+ * - levels[n]      uint8   TriageLevel
+ * - types[n]       uint8   EmergencyType
+ * - stringEnds[5n] uint32  end offset in the arena of caseID, patient
+ *                          name, symptoms, arrival time, arrival date
+ *                          (each string starts where the previous ends)
+ * - arena          bytes   all strings back to back, no separators
+ * 
+ * Cases are written in the engine's storage order. For the heap
+ * engines that is a valid heap already, so the bulk insert on load
+ * only compares and never moves an entry.
+ * 
+ * Loading maps the file read-only, checks the header and every column
+ * against the file size, and builds the cases straight into the
+ * queue's payload slots (restoreBatch). A file that fails any check is
+ * rejected as a whole and the caller falls back to the CSV import.
+ * 
+ * Time Complexity:
+ * - Write: O(n + arena)
+ * - Load: O(n + arena), one sequential pass over the mapped file
+ */
+
+class CaseSnapshot
+{
+public:
+    static const uint32_t VERSION = 1;
+    
+    // Write every waiting case of the queue to `filename`
+    static bool write(const std::string &filename, const PriorityQueue &queue);
+    
+    // Add the cases of a snapshot to the queue (returns the number of
+    // cases loaded, -1 if the file is missing or not a valid snapshot)
+    static int load(const std::string &filename, PriorityQueue &queue);
+};
+
+#endif
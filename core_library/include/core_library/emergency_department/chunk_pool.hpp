@@ -0,0 +1,84 @@
+#ifndef CHUNK_POOL_HPP
+#define CHUNK_POOL_HPP
+
+/*
+ * CHUNK POOL - RECYCLING ALLOCATOR FOR FIXED-SIZE BLOCKS
+ *
+ * Concept: Free list of equally sized arrays ("chunks")
+ * - acquire() hands out a cached chunk, or allocates a new one
+ * - release() puts a chunk back on the free list instead of deleting it
+ * - trim() gives cached chunks back to the system
+ *
+ * Containers that grow chunk by chunk never move the elements they
+ * already hold, and a container that shrinks and grows again (or a
+ * short-lived temporary container) reuses memory instead of going
+ * through new/delete every time.
+ *
+ * Time Complexity:
+ * - Acquire: O(1) amortized
+ * - Release: O(1) amortized
+ */
+
+template <typename T, int ChunkSize>
+class ChunkPool
+{
+private:
+    T **freeChunks;    // Cached chunks ready for reuse
+    int freeCount;     // Number of cached chunks
+    int freeCapacity;  // Capacity of the freeChunks array
+
+    ChunkPool(const ChunkPool &);
+    ChunkPool &operator=(const ChunkPool &);
+
+public:
+    ChunkPool() : freeChunks(nullptr), freeCount(0), freeCapacity(0) {}
+
+    ~ChunkPool()
+    {
+        trim(0);
+        delete[] freeChunks;
+    }
+
+    // Get a chunk of ChunkSize elements
+    T *acquire()
+    {
+        if (freeCount > 0)
+            return freeChunks[--freeCount];
+
+        return new T[ChunkSize];
+    }
+
+    // Return a chunk to the pool for later reuse
+    void release(T *chunk)
+    {
+        if (chunk == nullptr)
+            return;
+
+        if (freeCount == freeCapacity)
+        {
+            int newCapacity = freeCapacity == 0 ? 8 : freeCapacity * 2;
+            T **newArr = new T *[newCapacity];
+            for (int i = 0; i < freeCount; i++)
+                newArr[i] = freeChunks[i];
+            delete[] freeChunks;
+            freeChunks = newArr;
+            freeCapacity = newCapacity;
+        }
+
+        freeChunks[freeCount++] = chunk;
+    }
+
+    // Free cached chunks until at most `keep` remain
+    void trim(int keep = 0)
+    {
+        while (freeCount > keep)
+            delete[] freeChunks[--freeCount];
+    }
+
+    // Number of chunks currently cached
+    int cachedChunks() const { return freeCount; }
+
+    static int chunkSize() { return ChunkSize; }
+};
+
+#endif
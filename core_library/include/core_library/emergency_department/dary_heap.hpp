@@ -0,0 +1,356 @@
+#ifndef DARY_HEAP_HPP
+#define DARY_HEAP_HPP
+
+#include "core_library/emergency_department/frontier_heap.hpp"
+#include <cstdint>
+
+/*
+ * INDEXED D-ARY HEAP - CACHE-FRIENDLY MIN-HEAP OF (KEY, HANDLE) ENTRIES
+ * 
+ * Concept: Min-Heap where every node has up to Arity (4 or 8) children
+ * - Root = highest priority (minimum key)
+ * - Tree is log_d(n) levels deep instead of log_2(n)
+ * - Sifting down scans all children of a node, sifting up is shorter
+ * 
+ * Array representation:
+ * - Parent(i) = (i-1)/d
+ * - Children(i) = d*i + 1 ... d*i + d
+ * 
+ * Structure of arrays:
+ * - keys[i]    = 64-bit key of node i
+ * - handles[i] = payload handle of node i (parallel array)
+ * The keys array is offset so that every group of children starts on
+ * a 64-byte boundary: the 8 children of an 8-ary node are exactly one
+ * cache line of keys, the 4 children of a 4-ary node half a line.
+ * Handles are only touched when an entry actually moves.
+ * 
+ * Same interface as IndexedHeap (position[handle] = heap index).
+ * 
+ * Time Complexity:
+ * - Push: O(log_d n)
+ * - Push batch of k: O(n + k) rebuild, or O(k log_d n) for a small batch
+ * - Pop / Erase / Change key: O(d log_d n)
+ * - Top: O(1)
+ * - Top K in order: O(K d log K) (heap is not modified)
+ */
+
+template <int Arity>
+class IndexedDaryHeap
+{
+private:
+    static const int LINE_BYTES = 64;                    // Cache line size
+    static const int LINE_KEYS = LINE_BYTES / 8;         // Keys per cache line
+    
+    uint64_t *keyBlock;    // Allocation holding the keys
+    uint64_t *keys;        // Key per heap node (children groups line-aligned)
+    int *handles;          // Handle per heap node
+    int heapCapacity;      // Allocated nodes
+    int size;              // Current number of entries
+    int *position;         // Heap index per handle (-1 = not queued)
+    int handleCapacity;    // Handles covered by position[]
+    
+    IndexedDaryHeap(const IndexedDaryHeap &);
+    IndexedDaryHeap &operator=(const IndexedDaryHeap &);
+    
+    // Get parent index
+    static int parent(int i) { return (i - 1) / Arity; }
+    
+    // Get first child index
+    static int firstChild(int i) { return Arity * i + 1; }
+    
+    // Write an entry into node `index` and record its position
+    void place(int index, uint64_t key, int handle)
+    {
+        keys[index] = key;
+        handles[index] = handle;
+        position[handle] = index;
+    }
+    
+    /*
+     * HEAPIFY UP (Bubble Up)
+     * Pull parents down into the hole while they have lower priority,
+     * then write the entry once into the remaining hole.
+     */
+    void heapifyUp(int index)
+    {
+        uint64_t key = keys[index];
+        int handle = handles[index];
+        
+        while (index > 0 && key < keys[parent(index)])
+        {
+            int p = parent(index);
+            place(index, keys[p], handles[p]);
+            index = p;
+        }
+        
+        place(index, key, handle);
+    }
+    
+    /*
+     * HEAPIFY DOWN (Bubble Down)
+     * Find the smallest key among the node's children (one contiguous
+     * run of keys), pull it up into the hole while it beats the moving
+     * entry, then write the entry once into the remaining hole.
+     */
+    void heapifyDown(int index)
+    {
+        uint64_t key = keys[index];
+        int handle = handles[index];
+        
+        while (firstChild(index) < size)
+        {
+            int first = firstChild(index);
+            int last = first + Arity < size ? first + Arity : size;
+            
+            // Child with highest priority (lowest key)
+            int highest = first;
+            uint64_t highestKey = keys[first];
+            for (int c = first + 1; c < last; c++)
+            {
+                if (keys[c] < highestKey)
+                {
+                    highest = c;
+                    highestKey = keys[c];
+                }
+            }
+            
+            // Stop once the moving entry beats every child
+            if (key <= highestKey)
+                break;
+            
+            place(index, highestKey, handles[highest]);
+            index = highest;
+        }
+        
+        place(index, key, handle);
+    }
+    
+    // Remove the entry at a heap index and repair the heap
+    void removeAt(int index)
+    {
+        position[handles[index]] = -1;
+        
+        size--;
+        if (index == size)
+            return;
+        
+        place(index, keys[size], handles[size]);
+        
+        if (index > 0 && keys[index] < keys[parent(index)])
+            heapifyUp(index);
+        else
+            heapifyDown(index);
+    }
+
+public:
+    IndexedDaryHeap()
+        : keyBlock(nullptr), keys(nullptr), handles(nullptr), heapCapacity(0), size(0),
+          position(nullptr), handleCapacity(0) {}
+    
+    ~IndexedDaryHeap()
+    {
+        delete[] keyBlock;
+        delete[] handles;
+        delete[] position;
+    }
+    
+    bool isEmpty() const { return size == 0; }
+    int getSize() const { return size; }
+    
+    static int arity() { return Arity; }
+    
+    // Make room for `capacity` entries
+    void reserve(int capacity)
+    {
+        if (capacity <= heapCapacity)
+            return;
+        
+        int newCapacity = heapCapacity == 0 ? 16 : heapCapacity;
+        while (newCapacity < capacity)
+            newCapacity *= 2;
+        
+        // Over-allocate one line, then shift so &keys[1] is line-aligned
+        uint64_t *newBlock = new uint64_t[newCapacity + LINE_KEYS];
+        uintptr_t firstChildAddress = reinterpret_cast<uintptr_t>(newBlock + 1);
+        uintptr_t aligned = (firstChildAddress + LINE_BYTES - 1) & ~static_cast<uintptr_t>(LINE_BYTES - 1);
+        uint64_t *newKeys = reinterpret_cast<uint64_t *>(aligned) - 1;
+        int *newHandles = new int[newCapacity];
+        
+        for (int i = 0; i < size; i++)
+        {
+            newKeys[i] = keys[i];
+            newHandles[i] = handles[i];
+        }
+        delete[] keyBlock;
+        delete[] handles;
+        keyBlock = newBlock;
+        keys = newKeys;
+        handles = newHandles;
+        heapCapacity = newCapacity;
+    }
+    
+    // Allow handles 0..capacity-1
+    void reserveHandles(int capacity)
+    {
+        if (capacity <= handleCapacity)
+            return;
+        
+        int newCapacity = handleCapacity == 0 ? 16 : handleCapacity;
+        while (newCapacity < capacity)
+            newCapacity *= 2;
+        
+        int *newPosition = new int[newCapacity];
+        for (int i = 0; i < handleCapacity; i++)
+        {
+            newPosition[i] = position[i];
+        }
+        for (int i = handleCapacity; i < newCapacity; i++)
+        {
+            newPosition[i] = -1;
+        }
+        delete[] position;
+        position = newPosition;
+        handleCapacity = newCapacity;
+    }
+    
+    // Insert an entry (level is not needed by a heap)
+    void push(uint64_t key, int handle, int /*level*/)
+    {
+        reserve(size + 1);
+        reserveHandles(handle + 1);
+        
+        place(size, key, handle);
+        heapifyUp(size);
+        size++;
+    }
+    
+    /*
+     * PUSH BATCH (Bulk insert)
+     * A batch that is large next to the heap is appended as-is and the
+     * whole array is heapified bottom-up (Floyd): every parent, last to
+     * first, is sifted down once, which is O(n + k) in total. A small
+     * batch is sifted in entry by entry instead, O(k log_d n).
+     */
+    void pushBatch(const uint64_t batchKeys[], const int batchHandles[], const int batchLevels[], int count)
+    {
+        if (count <= 0)
+            return;
+        
+        if (count * 4 < size)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                push(batchKeys[i], batchHandles[i], batchLevels[i]);
+            }
+            return;
+        }
+        
+        reserve(size + count);
+        for (int i = 0; i < count; i++)
+        {
+            reserveHandles(batchHandles[i] + 1);
+            place(size + i, batchKeys[i], batchHandles[i]);
+        }
+        size += count;
+        
+        for (int i = parent(size - 1); i >= 0; i--)
+        {
+            heapifyDown(i);
+        }
+    }
+    
+    // Handle / key of the highest priority entry (heap must not be empty)
+    int top() const { return handles[0]; }
+    uint64_t topKey() const { return keys[0]; }
+    
+    // Remove the highest priority entry
+    void pop() { removeAt(0); }
+    
+    // Remove the entry of a handle
+    void erase(int handle)
+    {
+        if (contains(handle))
+            removeAt(position[handle]);
+    }
+    
+    // Give a handle a new key (and level) and restore heap order
+    void changeKey(int handle, uint64_t key, int /*level*/)
+    {
+        int index = position[handle];
+        uint64_t oldKey = keys[index];
+        keys[index] = key;
+        
+        if (key < oldKey)
+            heapifyUp(index);
+        else
+            heapifyDown(index);
+    }
+    
+    // Write the handles of the K highest priority entries, in priority
+    // order, into out[] (returns how many were written)
+    int topK(int k, int out[]) const
+    {
+        if (k > size)
+            k = size;
+        if (k <= 0)
+            return 0;
+        
+        FrontierHeap frontier(k * (Arity - 1) + 1);
+        frontier.push(keys[0], 0);
+        
+        int count = 0;
+        while (count < k)
+        {
+            int index = frontier.pop();
+            out[count++] = handles[index];
+            
+            int first = firstChild(index);
+            int last = first + Arity < size ? first + Arity : size;
+            for (int c = first; c < last; c++)
+            {
+                frontier.push(keys[c], c);
+            }
+        }
+        return count;
+    }
+    
+    // Is this handle queued? / its current key
+    bool contains(int handle) const { return handle < handleCapacity && position[handle] >= 0; }
+    uint64_t keyOf(int handle) const { return keys[position[handle]]; }
+    
+    // Rename handles: newHandleOf[old] = new (used when the owner compacts)
+    void remapHandles(const int *newHandleOf)
+    {
+        for (int i = 0; i < handleCapacity; i++)
+        {
+            position[i] = -1;
+        }
+        for (int i = 0; i < size; i++)
+        {
+            handles[i] = newHandleOf[handles[i]];
+            position[handles[i]] = i;
+        }
+    }
+    
+    // Remove every entry
+    void clear()
+    {
+        for (int i = 0; i < size; i++)
+        {
+            position[handles[i]] = -1;
+        }
+        size = 0;
+    }
+    
+    // Visit every entry in storage order: visit(key, handle)
+    template <typename Visitor>
+    void forEach(Visitor visit) const
+    {
+        for (int i = 0; i < size; i++)
+        {
+            visit(keys[i], handles[i]);
+        }
+    }
+};
+
+#endif
@@ -6,6 +6,8 @@
 #include <iomanip>
 #include <sstream>
 #include <ctime>
+#include <string_view>
+#include "core_library/record_parser.hpp"
 
 // Triage Levels (Standard Emergency Department Classification)
 enum TriageLevel
@@ -34,7 +36,7 @@ struct EmergencyCase
     std::string symptoms;
     std::string arrivalTime;
     std::string arrivalDate;
-    int waitingMinutes;  // For priority escalation
+    time_t arrivalEpoch;  // Arrival as seconds since epoch (for priority key)
     
     // Constructor
     EmergencyCase();
@@ -46,14 +48,29 @@ struct EmergencyCase
     // Display case information
     void display() const;
     
-    // Get priority score (for comparison in heap)
-    // Lower score = higher priority
-    int getPriorityScore() const;
+    // Get priority key (for comparison in heap)
+    // Lower key = higher priority; does not change while the case waits
+    long long getPriorityKey() const;
+    
+    // Minutes waited so far (derived from arrival, only for display)
+    int getWaitingMinutes() const;
+    int getWaitingMinutes(time_t now) const;
+    
+    // Longest acceptable wait for the triage level, in minutes
+    int getEscalationThreshold() const;
+    
+    // First moment the wait exceeds the threshold (0 = never escalates)
+    time_t getEscalationDeadline() const;
     
     // Convert to string for file storage
     std::string toString() const;
     
-    // Parse from file string
+    // Parse from file string (false = malformed line, see `error`;
+    // `out` is reused, so its string buffers are kept between lines)
+    static bool parse(std::string_view line, EmergencyCase& out, RecordError& error);
+    
+    // Parse from file string (a malformed line gives the fields read
+    // before the bad one)
     static EmergencyCase fromString(const std::string& line);
     
     // Get triage level name
@@ -73,6 +90,6 @@ struct EmergencyCase
 // Helper functions
 std::string getCurrentTimeString();
 std::string getCurrentDateString();
-int calculateWaitingTime(const std::string& arrivalTime, const std::string& arrivalDate);
+time_t parseArrivalEpoch(const std::string& arrivalTime, const std::string& arrivalDate);
 
 #endif
\ No newline at end of file
@@ -3,6 +3,9 @@
 
 #include "core_library/emergency_department/priority_queue.hpp"
 #include "core_library/emergency_department/emergency_case.hpp"
+#include "core_library/emergency_department/wait_histogram.hpp"
+#include "core_library/emergency_department/case_journal.hpp"
+#include <iosfwd>
 #include <string>
 
 // ANSI color codes
@@ -15,12 +18,21 @@
 #define C_CYAN "\033[36m"
 #define C_BOLD "\033[1m"
 
-class EmergencyOfficer
+class EmergencyOfficer : public EscalationListener
 {
 private:
     PriorityQueue emergencyQueue;
     int nextCaseNumber;  // Auto-increment for case IDs
     
+    // Every queue change is journaled on top of the binary snapshot
+    CaseJournal journal;
+    static const int COMPACT_EVERY = 1000;  // Journal records per snapshot
+    static const int MAX_INTAKE_PATIENTS = 500;  // Per mass-casualty intake
+    
+    // Door-to-treatment times of cases treated this session
+    WaitHistogram waitByLevel[5];  // Per TriageLevel (index = level - 1)
+    WaitHistogram waitByType[3];   // Per EmergencyType
+    
     // Helper functions
     std::string generateNextCaseID();
     void displayTriageInfo() const;
@@ -29,11 +41,24 @@ private:
     EmergencyType selectEmergencyType() const;
     void displayStatistics() const;
     void displayCaseHistory() const;
+    void applyRetriage(const std::string& caseID);
+    void applyCancellation(const std::string& caseID);
+    
+    // Door-to-treatment histograms: count a treated case / print the
+    // percentile table (dashboard and report)
+    void recordTreatment(const EmergencyCase& treatedCase, time_t now);
+    void writeWaitPercentiles(std::ostream& out) const;
     
-    // File I/O
+    // File I/O: binary snapshot (normal path), CSV (import / export)
+    bool loadSnapshot(const std::string& filename);
     void loadCasesFromFile(const std::string& filename);
-    void saveCasesToFile(const std::string& filename) const;
+    bool saveCasesToFile(const std::string& filename) const;
     
+    // Recovery and compaction (snapshot + journal)
+    void replayJournal(const std::string& filename);
+    bool compactJournal();
+    bool saveSnapshot();
+
 public:
     // Constructor
     EmergencyOfficer();
@@ -58,6 +83,10 @@ public:
     // Cases waiting too long get priority boost
     void checkPriorityEscalation();
     
+    // Alert printed as soon as a case crosses its escalation deadline
+    // (the queue is advanced before every menu)
+    void onEscalation(const EmergencyCase& emergencyCase, time_t now);
+    
     // Feature 2: Search Case by ID or Name
     void searchCase();
     
@@ -74,6 +103,20 @@ public:
     // Feature 6: Export Cases to Report
     void exportCasesToFile();
     
+    // Feature 7: Re-Triage a Waiting Case
+    void retriageCase();
+    
+    // Feature 8: Cancel Case (Left Without Being Seen)
+    void cancelPendingCase();
+    
+    // Feature 9: Mass-Casualty Intake
+    // Log a whole group of patients from one incident in one call
+    void massCasualtyIntake();
+    
+    // Feature 10: Export Cases as CSV
+    // Readable copy of the waiting cases (emergency_cases.txt)
+    void exportCasesToCsv();
+    
     // Menu and main loop
     void displayMenu();
     void run();
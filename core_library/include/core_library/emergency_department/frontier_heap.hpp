@@ -0,0 +1,110 @@
+#ifndef FRONTIER_HEAP_HPP
+#define FRONTIER_HEAP_HPP
+
+#include <cstdint>
+
+/*
+ * FRONTIER HEAP - SCRATCH MIN-HEAP FOR TOP-K WALKS
+ * 
+ * Concept: Reading the K smallest entries of a heap without touching it
+ * - The frontier starts with the heap's root
+ * - Pop the smallest frontier node, report it, push its children
+ * - After K pops the K smallest entries were reported in order
+ * 
+ * Only (key, node index) pairs are stored, so the frontier stays small:
+ * at most K * (d - 1) + 1 nodes for a d-ary heap.
+ * 
+ * Time Complexity:
+ * - Top-K walk over a d-ary heap: O(K d log K)
+ */
+
+class FrontierHeap
+{
+private:
+    uint64_t *keys;    // Key per frontier node
+    int *indexes;      // Index of the node in the walked heap
+    int size;          // Nodes in the frontier
+    int capacity;      // Allocated nodes
+    
+    FrontierHeap(const FrontierHeap &);
+    FrontierHeap &operator=(const FrontierHeap &);
+    
+    void grow()
+    {
+        int newCapacity = capacity == 0 ? 16 : capacity * 2;
+        uint64_t *newKeys = new uint64_t[newCapacity];
+        int *newIndexes = new int[newCapacity];
+        for (int i = 0; i < size; i++)
+        {
+            newKeys[i] = keys[i];
+            newIndexes[i] = indexes[i];
+        }
+        delete[] keys;
+        delete[] indexes;
+        keys = newKeys;
+        indexes = newIndexes;
+        capacity = newCapacity;
+    }
+
+public:
+    explicit FrontierHeap(int initialCapacity)
+        : keys(nullptr), indexes(nullptr), size(0), capacity(0)
+    {
+        while (capacity < initialCapacity)
+            grow();
+    }
+    
+    ~FrontierHeap()
+    {
+        delete[] keys;
+        delete[] indexes;
+    }
+    
+    bool isEmpty() const { return size == 0; }
+    
+    // Add a node (sift up through the hole)
+    void push(uint64_t key, int index)
+    {
+        if (size == capacity)
+            grow();
+        
+        int i = size++;
+        while (i > 0 && key < keys[(i - 1) / 2])
+        {
+            keys[i] = keys[(i - 1) / 2];
+            indexes[i] = indexes[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        keys[i] = key;
+        indexes[i] = index;
+    }
+    
+    // Remove the smallest node and return its index (must not be empty)
+    int pop()
+    {
+        int result = indexes[0];
+        size--;
+        
+        uint64_t key = keys[size];
+        int index = indexes[size];
+        int i = 0;
+        while (2 * i + 1 < size)
+        {
+            int child = 2 * i + 1;
+            if (child + 1 < size && keys[child + 1] < keys[child])
+                child++;
+            if (key <= keys[child])
+                break;
+            
+            keys[i] = keys[child];
+            indexes[i] = indexes[child];
+            i = child;
+        }
+        keys[i] = key;
+        indexes[i] = index;
+        
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef INDEXED_HEAP_HPP
+#define INDEXED_HEAP_HPP
+
+#include <cstdint>
+
+/*
+ * INDEXED HEAP - BINARY MIN-HEAP OF (KEY, HANDLE) ENTRIES
+ * 
+ * Concept: Binary Min-Heap stored in array
+ * - Root = highest priority (minimum key)
+ * - Complete binary tree property
+ * - Parent always has higher priority than children
+ * 
+ * Array representation:
+ * - Parent(i) = (i-1)/2
+ * - Left child(i) = 2*i + 1
+ * - Right child(i) = 2*i + 2
+ * 
+ * Each entry is { 64-bit key, handle }. The handle names a payload slot
+ * owned by the caller (see PriorityQueue); position[handle] remembers
+ * where that entry currently sits, so any entry can be re-keyed or
+ * removed without searching.
+ * 
+ * Time Complexity:
+ * - Push: O(log n)
+ * - Push batch of k: O(n + k) rebuild, or O(k log n) for a small batch
+ * - Pop / Erase / Change key: O(log n)
+ * - Top: O(1)
+ * - Top K in order: O(K log K) (heap is not modified)
+ */
+
+class IndexedHeap
+{
+public:
+    struct Entry
+    {
+        uint64_t key;
+        int handle;
+    };
+
+private:
+    Entry *heap;           // Heap of entries
+    int heapCapacity;      // Allocated entries
+    int size;              // Current number of entries
+    int *position;         // Heap index per handle (-1 = not queued)
+    int handleCapacity;    // Handles covered by position[]
+    
+    IndexedHeap(const IndexedHeap &);
+    IndexedHeap &operator=(const IndexedHeap &);
+    
+    // Get parent index
+    int parent(int i) const { return (i - 1) / 2; }
+    
+    // Get left child index
+    int leftChild(int i) const { return 2 * i + 1; }
+    
+    // Get right child index
+    int rightChild(int i) const { return 2 * i + 2; }
+    
+    // Write an entry into the heap and record its position
+    void place(int index, const Entry &entry)
+    {
+        heap[index] = entry;
+        position[entry.handle] = index;
+    }
+    
+    // Move element up to maintain heap property (after insertion)
+    void heapifyUp(int index);
+    
+    // Move element down to maintain heap property (after removal)
+    void heapifyDown(int index);
+    
+    // Remove the entry at a heap index and repair the heap
+    void removeAt(int index);
+
+public:
+    IndexedHeap();
+    ~IndexedHeap();
+    
+    bool isEmpty() const { return size == 0; }
+    int getSize() const { return size; }
+    
+    // Make room for `capacity` entries
+    void reserve(int capacity);
+    
+    // Allow handles 0..capacity-1
+    void reserveHandles(int capacity);
+    
+    // Insert an entry (level is not needed by a heap)
+    void push(uint64_t key, int handle, int level);
+    
+    // Insert many entries at once (bottom-up heapify for a large batch)
+    void pushBatch(const uint64_t keys[], const int handles[], const int levels[], int count);
+    
+    // Handle / key of the highest priority entry (heap must not be empty)
+    int top() const { return heap[0].handle; }
+    uint64_t topKey() const { return heap[0].key; }
+    
+    // Remove the highest priority entry
+    void pop();
+    
+    // Remove the entry of a handle
+    void erase(int handle);
+    
+    // Give a handle a new key (and level) and restore heap order
+    void changeKey(int handle, uint64_t key, int level);
+    
+    // Write the handles of the K highest priority entries, in priority
+    // order, into out[] (returns how many were written)
+    int topK(int k, int out[]) const;
+    
+    // Is this handle queued? / its current key
+    bool contains(int handle) const { return handle < handleCapacity && position[handle] >= 0; }
+    uint64_t keyOf(int handle) const { return heap[position[handle]].key; }
+    
+    // Rename handles: newHandleOf[old] = new (used when the owner compacts)
+    void remapHandles(const int *newHandleOf);
+    
+    // Remove every entry
+    void clear();
+    
+    // Visit every entry in storage order: visit(key, handle)
+    template <typename Visitor>
+    void forEach(Visitor visit) const
+    {
+        for (int i = 0; i < size; i++)
+        {
+            visit(heap[i].key, heap[i].handle);
+        }
+    }
+};
+
+#endif
@@ -2,90 +2,410 @@
 #define PRIORITY_QUEUE_HPP
 
 #include "core_library/emergency_department/emergency_case.hpp"
+#include "core_library/emergency_department/chunk_pool.hpp"
+#include "core_library/emergency_department/indexed_heap.hpp"
+#include "core_library/emergency_department/dary_heap.hpp"
+#include "core_library/emergency_department/triage_buckets.hpp"
 #include <iostream>
+#include <cstdint>
 
 /*
- * PRIORITY QUEUE - MIN-HEAP IMPLEMENTATION
+ * PRIORITY QUEUE - TRIAGE QUEUE OF EMERGENCY CASES
  * 
- * Concept: Binary Min-Heap stored in array
- * - Root = highest priority (minimum value)
- * - Complete binary tree property
- * - Parent always has higher priority than children
+ * Ordering engine (chosen at build time, see TriageEngine below):
+ * - IndexedDaryHeap: 4-ary (or 8-ary) min-heap, keys in their own
+ *                    array, O(log_d n) insert / remove (default)
+ * - IndexedHeap:     binary min-heap, O(log n) insert / remove
+ * - TriageBuckets:   one FIFO ring per triage level, O(1) insert / remove
+ * Both order the same entries: { 64-bit key, handle }
+ * - key    = [ priority key (32 bits) | sequence number (32 bits) ]
+ *            priority key = triage * 6000 + arrival epoch (seconds)
+ *            sequence     = insertion order, breaks ties (FIFO)
+ * - handle = slot of the EmergencyCase in the payload storage
+ * The engine compares and moves only these small entries; a case's
+ * strings are copied once on enqueue and once on dequeue.
  * 
- * Array representation:
- * - Parent(i) = (i-1)/2
- * - Left child(i) = 2*i + 1
- * - Right child(i) = 2*i + 2
+ * Payload storage: fixed-size chunks of EmergencyCase slots
+ * - Slot h lives in chunks[h / CHUNK_SIZE][h % CHUNK_SIZE]
+ * - Growing adds one chunk; existing cases never move
+ * - Chunks come from (and go back to) a shared ChunkPool
+ * - Slots freed by dequeue are recycled through a free list
+ * - There is no fixed capacity, the queue never rejects a case
  * 
- * Time Complexity:
- * - Insert: O(log n)
- * - Remove: O(log n)
+ * caseID index: hash table (open addressing, linear probing) -> handle
+ * 
+ * Running statistics (updated on enqueue, dequeue, cancel, re-triage):
+ * - cases per triage level and per emergency type
+ * - sum of arrival times, so total / average wait is one subtraction
+ * - per level, a small 4-ary heap of that level's keys; within one
+ *   level the key orders by arrival, so its top is the oldest case
+ * 
+ * Escalation deadlines (see EmergencyCase::getEscalationDeadline):
+ * - pending: 4-ary heap of cases that have not crossed their deadline,
+ *            keyed by [ deadline (32 bits) | sequence (32 bits) ]
+ * - overdue: cases already announced as overdue
+ * advanceEscalations(now) pops every pending deadline <= now, moves
+ * the case to overdue and tells the EscalationListener, so each case
+ * is announced once and nothing else is looked at.
+ * 
+ * Read-only access without copies:
+ * - cases() is a span view of the waiting cases in storage order
+ *   (chunk by chunk, unordered), usable with range-for
+ * - forEach(visit) calls visit(const EmergencyCase&) the same way
+ * - display / getTopCases give priority order
+ * 
+ * Time Complexity (heap engines / bucket engine):
+ * - Insert: O(log n) / O(1) in arrival order (+ O(1) amortized chunk acquisition)
+ * - Insert batch of k: O(n + k) heap rebuild (O(k log n) for a small batch)
+ * - Remove: O(log n) / O(1) amortized
  * - Peek: O(1)
+ * - Top K in priority order: O(K log K) (no copy of the queue)
+ * - Statistics (counts, average / longest wait): O(1)
+ * - Overdue cases at `now`: O(overdue + newly overdue * log n)
+ * - Find by caseID: O(1) expected
+ * - Re-triage / cancel by caseID: O(log n) / O(1) amortized
+ */
+
+// Engine selection (CMake: -DED_TRIAGE_ENGINE=DARY|HEAP|BUCKET and
+// -DED_HEAP_ARITY=4|8 for the d-ary heap)
+#if defined(ED_TRIAGE_ENGINE_BUCKET)
+typedef TriageBuckets TriageEngine;
+#elif defined(ED_TRIAGE_ENGINE_BINARY)
+typedef IndexedHeap TriageEngine;
+#else
+#ifndef ED_HEAP_ARITY
+#define ED_HEAP_ARITY 4
+#endif
+typedef IndexedDaryHeap<ED_HEAP_ARITY> TriageEngine;
+#endif
+
+/*
+ * Receives a call as soon as advanceEscalations() sees a case cross its
+ * escalation deadline. The listener may read the queue but must not
+ * change it from inside the call.
  */
+class EscalationListener
+{
+public:
+    virtual ~EscalationListener() {}
+    virtual void onEscalation(const EmergencyCase &emergencyCase, time_t now) = 0;
+};
 
 class PriorityQueue
 {
 private:
-    static const int MAX_SIZE = 100;  // Maximum capacity
-    EmergencyCase heap[MAX_SIZE];     // Array to store heap
-    int size;                          // Current number of elements
+    static const int CHUNK_SIZE = 256;  // Cases per storage chunk
+    
+    TriageEngine engine;               // Orders the waiting cases
+    uint32_t nextSequence;             // Tie-breaker for equal priority keys
     
-    // Helper functions for heap operations
+    EmergencyCase **chunks;            // Payload chunk directory
+    int chunkCount;                    // Chunks currently owned
+    int directoryCapacity;             // Slots in the chunk directory
+    int slotCount;                     // Payload slots handed out so far
+    int *freeSlots;                    // Recycled payload slots
+    int freeCount;                     // Number of recycled slots
+    int freeCapacity;                  // Allocated recycled-slot entries
     
-    // Get parent index
-    int parent(int i) const { return (i - 1) / 2; }
+    int *indexSlots;                   // caseID hash table (handles, -1 = empty)
+    uint32_t *indexHashes;             // Cached hash per table slot
+    int indexCapacity;                 // Table size (power of two)
+    int indexCount;                    // Used table slots
     
-    // Get left child index
-    int leftChild(int i) const { return 2 * i + 1; }
+    int levelCount[6];                 // Cases per TriageLevel (index 0 unused)
+    int typeCount[3];                  // Cases per EmergencyType
+    long long arrivalSum;              // Sum of arrivalEpoch over all cases
+    IndexedDaryHeap<4> oldestByLevel[5];  // Per-level keys, top = oldest arrival
     
-    // Get right child index
-    int rightChild(int i) const { return 2 * i + 2; }
+    IndexedDaryHeap<4> pendingDeadlines;  // Not yet overdue, top = next deadline
+    IndexedDaryHeap<4> overdueDeadlines;  // Already announced as overdue
+    EscalationListener *escalationListener;  // Told about new overdue cases
     
-    // Swap two elements
-    void swap(int i, int j);
+    // Pool shared by every queue, so temporary queues reuse memory
+    static ChunkPool<EmergencyCase, CHUNK_SIZE> &chunkPool();
     
-    // Move element up to maintain heap property (after insertion)
-    void heapifyUp(int index);
+    // EmergencyCase copies into and out of payload storage, all queues
+    static long long caseCopies;
     
-    // Move element down to maintain heap property (after removal)
-    void heapifyDown(int index);
+    static void copyCase(EmergencyCase &to, const EmergencyCase &from)
+    {
+        to = from;
+        caseCopies++;
+    }
+    
+    // Payload access by handle
+    EmergencyCase &payload(int h) { return chunks[h / CHUNK_SIZE][h % CHUNK_SIZE]; }
+    const EmergencyCase &payload(int h) const { return chunks[h / CHUNK_SIZE][h % CHUNK_SIZE]; }
+    
+    // Build the packed comparison key for a case
+    static uint64_t makeKey(const EmergencyCase &emergencyCase, uint32_t sequence);
+    
+    // Payload slot management
+    int allocateSlot();
+    void freeSlot(int h);
+    
+    // Take one more chunk from the pool
+    void addChunk();
+    
+    // Give every chunk back to the pool
+    void releaseChunks();
+    
+    // Take a case out of the engine, the index and its slot
+    void removeCase(int h);
+    
+    // Running statistics: count a stored case in / out
+    void statsAdd(int h, uint64_t key);
+    void statsAddBatch(const uint64_t keys[], const int handles[], const int levels[], int count);
+    void statsRemove(int h);
+    void statsReset();
+    
+    // Escalation deadlines: track a stored case / stop tracking it
+    void deadlineAdd(int h, uint64_t key);
+    void deadlineAddBatch(const uint64_t keys[], const int handles[], const int levels[], int count);
+    void deadlineRemove(int h);
+    
+    // caseID index operations
+    static uint32_t hashCaseID(const std::string &caseID);
+    int indexFind(const std::string &caseID) const;
+    void indexInsert(int h);
+    void indexErase(int h);
+    void indexRebuild(int capacity);
+    
+    /*
+     * INSERT BATCH (shared by enqueueBatch and restoreBatch)
+     * fill(i, slot) writes case i straight into its payload slot and
+     * returns the case's sequence number.
+     * 1. Grow storage and the caseID index once for the whole batch
+     * 2. Fill every slot, index it, build its key
+     * 3. Hand all { key, slot } entries to the engine in one call
+     *    (heap: append + bottom-up heapify, or sift in a small batch),
+     *    and the same for the statistics and deadline heaps
+     */
+    template <typename Filler>
+    int insertBatch(int count, Filler fill)
+    {
+        if (count <= 0)
+            return 0;
+        
+        reserve(getSize() + count);
+        if ((indexCount + count) * 2 > indexCapacity)
+            indexRebuild((indexCount + count) * 2);
+        
+        uint64_t *keys = new uint64_t[count];
+        int *handles = new int[count];
+        int *levels = new int[count];
+        
+        for (int i = 0; i < count; i++)
+        {
+            int h = allocateSlot();
+            uint32_t sequence = fill(i, payload(h));
+            indexInsert(h);
+            
+            keys[i] = makeKey(payload(h), sequence);
+            handles[i] = h;
+            levels[i] = payload(h).triageLevel;
+        }
+        
+        engine.pushBatch(keys, handles, levels, count);
+        statsAddBatch(keys, handles, levels, count);
+        deadlineAddBatch(keys, handles, levels, count);
+        
+        delete[] keys;
+        delete[] handles;
+        delete[] levels;
+        return count;
+    }
 
 public:
+    /*
+     * Unordered span view of the waiting cases
+     * Walks the payload slots in memory order and skips free slots.
+     * The view is invalidated by any change to the queue.
+     */
+    class CaseSpan
+    {
+    public:
+        class iterator
+        {
+        private:
+            const PriorityQueue *queue;
+            int handle;
+            
+            // Move to the next slot that holds a waiting case
+            void skipFree()
+            {
+                while (handle < queue->slotCount && !queue->engine.contains(handle))
+                    handle++;
+            }
+        
+        public:
+            iterator(const PriorityQueue *owner, int start) : queue(owner), handle(start) { skipFree(); }
+            
+            const EmergencyCase &operator*() const { return queue->payload(handle); }
+            const EmergencyCase *operator->() const { return &queue->payload(handle); }
+            
+            iterator &operator++()
+            {
+                handle++;
+                skipFree();
+                return *this;
+            }
+            
+            bool operator==(const iterator &other) const { return handle == other.handle; }
+            bool operator!=(const iterator &other) const { return handle != other.handle; }
+        };
+        
+        explicit CaseSpan(const PriorityQueue *owner) : queue(owner) {}
+        
+        iterator begin() const { return iterator(queue, 0); }
+        iterator end() const { return iterator(queue, queue->slotCount); }
+        int size() const { return queue->getSize(); }
+        bool empty() const { return queue->isEmpty(); }
+    
+    private:
+        const PriorityQueue *queue;
+    };
+    
     // Constructor
     PriorityQueue();
     
+    // Copy constructor / assignment / destructor (owns its chunks)
+    PriorityQueue(const PriorityQueue &other);
+    PriorityQueue &operator=(const PriorityQueue &other);
+    ~PriorityQueue();
+    
     // Check if queue is empty
     bool isEmpty() const;
     
-    // Check if queue is full
-    bool isFull() const;
-    
     // Get current size
     int getSize() const;
     
+    // Number of cases the queue can hold without taking another chunk
+    int getCapacity() const;
+    
+    // Make room for at least `capacity` cases up front
+    void reserve(int capacity);
+    
+    // Return chunks not needed for the current cases to the pool
+    // (releasePooled = true also frees the pool's cached chunks)
+    void shrinkToFit(bool releasePooled = false);
+    
     // Insert emergency case (enqueue with priority)
     bool enqueue(const EmergencyCase& emergencyCase);
     
+    // Insert many cases in one call (returns the number inserted)
+    int enqueueBatch(const EmergencyCase cases[], int count);
+    
+    // Rebuild saved cases (see CaseSnapshot): fill(i, EmergencyCase&)
+    // writes case i into its slot and returns its saved sequence number;
+    // cases given in saved storage order need no sifting
+    template <typename Filler>
+    int restoreBatch(int count, uint32_t savedNextSequence, Filler fill)
+    {
+        int restored = insertBatch(count, fill);
+        if (savedNextSequence > nextSequence)
+            nextSequence = savedNextSequence;
+        return restored;
+    }
+    
     // Remove highest priority case (dequeue)
     bool dequeue(EmergencyCase& emergencyCase);
     
     // View highest priority case without removing
     bool peek(EmergencyCase& emergencyCase) const;
     
-    // Display all cases in priority order (without modifying heap)
-    void display() const;
+    // Display cases in priority order (without modifying the queue):
+    // ranks first+1 .. first+count (count < 0 = all remaining)
+    void display(int first = 0, int count = -1) const;
     
-    // Update waiting times for all cases
-    void updateWaitingTimes();
+    // Copy the cases ranked offset+1 .. offset+k in priority order
+    // (returns how many were copied; `cases` must have room for k)
+    int getTopCases(EmergencyCase cases[], int k, int offset = 0) const;
     
-    // Get all cases as array (for file saving)
+    // Get all cases as array (copies every case)
+    // `cases` must have room for getSize() elements
     void getAllCases(EmergencyCase cases[], int& count) const;
     
+    // Read-only view of the waiting cases, unordered, no copies
+    CaseSpan cases() const { return CaseSpan(this); }
+    
+    // Call visit(const EmergencyCase&) for every waiting case, unordered
+    template <typename Visitor>
+    void forEach(Visitor visit) const
+    {
+        for (int h = 0; h < slotCount; h++)
+        {
+            if (engine.contains(h))
+                visit(payload(h));
+        }
+    }
+    
+    // Call visit(key, const EmergencyCase&) for every waiting case in
+    // the engine's storage order (heap array order for the heap engines)
+    template <typename Visitor>
+    void forEachEntry(Visitor visit) const
+    {
+        engine.forEach([&](uint64_t key, int handle) {
+            visit(key, payload(handle));
+        });
+    }
+    
+    // Sequence number the next enqueued case will get
+    uint32_t getNextSequence() const { return nextSequence; }
+    
+    // Whole EmergencyCase copies made by all queues so far (sifting
+    // moves keys and handles only; for benchmarks)
+    static long long getCaseCopies() { return caseCopies; }
+    
     // Clear all cases
     void clear();
     
     // Search for a case by ID
     bool findCase(const std::string& caseID, EmergencyCase& foundCase) const;
+    
+    // ========== Running statistics (O(1)) ==========
+    
+    // Waiting cases at one triage level / of one emergency type
+    int countAtLevel(TriageLevel level) const;
+    int countOfType(EmergencyType type) const;
+    
+    // Arrival time of the longest-waiting case at a level (0 = none)
+    time_t oldestArrival(TriageLevel level) const;
+    
+    // Sum of every case's waiting time at `now`, in seconds
+    long long totalWaitingSeconds(time_t now) const;
+    
+    // Longest current wait over all levels, in minutes
+    int longestWaitMinutes(time_t now) const;
+    
+    // ========== Escalation deadlines ==========
+    
+    // Subscribe to newly overdue cases (nullptr = nobody; not copied)
+    void setEscalationListener(EscalationListener *listener);
+    
+    // Move every case whose deadline is <= now to overdue and notify the
+    // listener once per case (returns how many became overdue)
+    int advanceEscalations(time_t now);
+    
+    // Cases overdue at `now` (advances first)
+    int overdueCount(time_t now);
+    
+    // Call visit(const EmergencyCase&) for every case overdue at `now`,
+    // unordered (advances first)
+    template <typename Visitor>
+    void forEachOverdue(time_t now, Visitor visit)
+    {
+        advanceEscalations(now);
+        overdueDeadlines.forEach([&](uint64_t, int handle) {
+            visit(static_cast<const EmergencyCase &>(payload(handle)));
+        });
+    }
+    
+    // Change a waiting case's triage level (keeps its arrival order)
+    bool updateTriage(const std::string& caseID, TriageLevel newLevel);
+    
+    // Remove a case that leaves without being treated
+    bool cancelCase(const std::string& caseID, EmergencyCase& cancelledCase);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,165 @@
+#ifndef TRIAGE_BUCKETS_HPP
+#define TRIAGE_BUCKETS_HPP
+
+#include "core_library/emergency_department/indexed_heap.hpp"
+#include <cstdint>
+
+/*
+ * TRIAGE BUCKETS - ONE FIFO RING PER TRIAGE LEVEL
+ * 
+ * Concept: Bucket queue specialised for the 5 TriageLevel values
+ * - Inside one level, the key order is simply arrival order, so each
+ *   level is a FIFO ring sorted by key (new arrivals go to the tail)
+ * - A 5-bit occupancy mask says which rings hold live entries
+ * - Escalation across levels (an old URGENT case beating a new
+ *   EMERGENCY case) only needs the heads: the most critical case is
+ *   the smallest key among at most 5 ring heads
+ * - An entry that does not belong at a ring's tail (a re-triaged case
+ *   keeps its old arrival time, a file may list cases out of order)
+ *   goes to a small side heap instead, whose top is the 6th "head"
+ * 
+ * Same interface as IndexedHeap: entries are { 64-bit key, handle }.
+ * 
+ * Removal from the middle of a ring (cancel / re-triage) is lazy:
+ * the handle's stamp is bumped, which makes its ring entry stale, and
+ * stale entries are skipped once they reach the head (a ring is
+ * compacted when more than half of it is stale). Every ring head is
+ * kept live, so top() is a plain read.
+ * 
+ * Time Complexity:
+ * - Push: O(1) for arrivals in time order
+ *         (O(log m) for the m entries held out of order)
+ * - Top: O(1) (compare up to 6 heads)
+ * - Pop / Erase: O(1) amortized
+ * - Change key: Erase + Push
+ * - Top K in order: O(K) merge of the ring heads and the side heap's top K
+ */
+
+class TriageBuckets
+{
+public:
+    struct Entry
+    {
+        uint64_t key;
+        int handle;
+        uint32_t stamp;    // Must match stamps[handle] to be live
+    };
+    
+    static const int LEVELS = 5;
+
+private:
+    static const uint64_t NOT_QUEUED = ~static_cast<uint64_t>(0);
+    
+    // Growable circular buffer of entries, sorted by key
+    struct Ring
+    {
+        Entry *data;
+        int capacity;   // Power of two
+        int head;       // Index of the first entry
+        int count;      // Entries in the ring (live + stale)
+        
+        Entry &at(int i) { return data[(head + i) & (capacity - 1)]; }
+        const Entry &at(int i) const { return data[(head + i) & (capacity - 1)]; }
+    };
+    
+    Ring rings[LEVELS];
+    int liveCount[LEVELS];     // Live ring entries per level
+    unsigned occupied;         // Bit (level - 1) set = ring has live entries
+    int size;                  // Live entries in total (rings + side heap)
+    
+    IndexedHeap outOfOrder;    // Entries that did not fit a ring's tail
+    
+    uint64_t *keys;            // Current key per handle (NOT_QUEUED = none)
+    uint32_t *stamps;          // Stamp of the handle's live ring entry
+    unsigned char *levels;     // Level per handle
+    int handleCapacity;        // Handles covered by the per-handle arrays
+    
+    TriageBuckets(const TriageBuckets &);
+    TriageBuckets &operator=(const TriageBuckets &);
+    
+    // Is this ring entry still the handle's current entry?
+    bool isLive(const Entry &entry) const { return stamps[entry.handle] == entry.stamp; }
+    
+    // Ring helpers
+    void growRing(Ring &ring, int capacity);
+    bool appendToRing(uint64_t key, int handle, int level);
+    void dropStaleHead(int level);
+    void compactRing(int level);
+    
+    // Level (1-5) of the ring holding the smallest head key (0 = none)
+    int bestLevel() const;
+    
+    // Handle of the smallest entry among ring heads and side heap
+    int topHandle() const;
+
+public:
+    TriageBuckets();
+    ~TriageBuckets();
+    
+    bool isEmpty() const { return size == 0; }
+    int getSize() const { return size; }
+    
+    // Make room for `capacity` entries (spread evenly over the rings)
+    void reserve(int capacity);
+    
+    // Allow handles 0..capacity-1
+    void reserveHandles(int capacity);
+    
+    // Insert an entry into the ring of its level (1-5)
+    void push(uint64_t key, int handle, int level);
+    
+    // Insert many entries at once; out-of-order ones are heapified
+    // into the side heap together
+    void pushBatch(const uint64_t batchKeys[], const int batchHandles[], const int batchLevels[], int count);
+    
+    // Handle / key of the highest priority entry (must not be empty)
+    int top() const { return topHandle(); }
+    uint64_t topKey() const { return keys[topHandle()]; }
+    
+    // Remove the highest priority entry
+    void pop();
+    
+    // Remove the entry of a handle
+    void erase(int handle);
+    
+    // Give a handle a new key and level
+    void changeKey(int handle, uint64_t key, int level);
+    
+    // Write the handles of the K highest priority entries, in priority
+    // order, into out[] (returns how many were written)
+    int topK(int k, int out[]) const;
+    
+    // Is this handle queued? / its current key
+    bool contains(int handle) const { return handle < handleCapacity && keys[handle] != NOT_QUEUED; }
+    uint64_t keyOf(int handle) const { return keys[handle]; }
+    
+    // Occupancy bitmask: bit (level - 1) set = that level's ring is in use
+    unsigned occupancy() const { return occupied; }
+    
+    // Entries currently held in the side heap
+    int outOfOrderCount() const { return outOfOrder.getSize(); }
+    
+    // Rename handles: newHandleOf[old] = new (used when the owner compacts)
+    void remapHandles(const int *newHandleOf);
+    
+    // Remove every entry
+    void clear();
+    
+    // Visit every live entry, level by level: visit(key, handle)
+    template <typename Visitor>
+    void forEach(Visitor visit) const
+    {
+        outOfOrder.forEach(visit);
+        for (int l = 0; l < LEVELS; l++)
+        {
+            for (int i = 0; i < rings[l].count; i++)
+            {
+                const Entry &entry = rings[l].at(i);
+                if (isLive(entry))
+                    visit(entry.key, entry.handle);
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef WAIT_HISTOGRAM_HPP
+#define WAIT_HISTOGRAM_HPP
+
+#include <cstdint>
+
+/*
+ * WAIT HISTOGRAM - LOG-BUCKETED (HDR-STYLE) HISTOGRAM OF WAIT TIMES
+ * 
+ * Concept: Count values in buckets whose width grows with the value
+ * - Values 0..63 seconds get one bucket each (exact)
+ * - Above that, every power-of-two range [2^m, 2^(m+1)) is split into
+ *   32 equal buckets, so a bucket is at most 1/32 of its value wide
+ * - Any value is reported within about 3% of its true size
+ * 
+ * Bucket index of a value v >= 64 (m = highest set bit of v):
+ *   shift = m - 5, top = v >> shift (32..63)
+ *   index = 64 + (shift - 1) * 32 + (top - 32)
+ * 
+ * Values up to 2^25 - 1 seconds (about 388 days) are covered; longer
+ * waits are counted in the last bucket. The counts live in a fixed
+ * array inside the object: recording never allocates.
+ * 
+ * Time Complexity:
+ * - Record: O(1)
+ * - Percentile: O(B), B = 672 buckets
+ */
+
+class WaitHistogram
+{
+private:
+    static const int SUB_BUCKETS = 64;                  // Exact buckets below 64 s
+    static const int HALF_BUCKETS = SUB_BUCKETS / 2;    // Buckets per power of two
+    static const int MAX_BITS = 25;                     // Values below 2^25 s
+    static const int BUCKETS = SUB_BUCKETS + (MAX_BITS - 6) * HALF_BUCKETS;
+    
+    uint64_t counts[BUCKETS];    // Values per bucket
+    uint64_t totalCount;         // Values recorded
+    long long totalSeconds;      // Sum of values (for the mean)
+    long long minSeconds;        // Smallest value recorded
+    long long maxSeconds;        // Largest value recorded
+    
+    // Bucket of a value / largest value that falls into a bucket
+    static int bucketOf(long long seconds);
+    static long long highestInBucket(int index);
+
+public:
+    // Constructor
+    WaitHistogram();
+    
+    // Count one wait (negative waits count as 0)
+    void record(long long seconds);
+    
+    // Forget every value
+    void reset();
+    
+    // Values recorded / smallest / largest / mean, in seconds
+    uint64_t getCount() const { return totalCount; }
+    long long getMin() const { return totalCount == 0 ? 0 : minSeconds; }
+    long long getMax() const { return maxSeconds; }
+    double getMean() const;
+    
+    // Wait that `percentile` percent (0..100) of the values do not
+    // exceed, in seconds (0 when nothing was recorded)
+    long long valueAtPercentile(double percentile) const;
+    
+    // Add another histogram's counts to this one
+    void add(const WaitHistogram &other);
+};
+
+#endif
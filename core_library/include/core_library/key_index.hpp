@@ -0,0 +1,403 @@
+#ifndef KEY_INDEX_HPP
+#define KEY_INDEX_HPP
+
+#include "mapped_file.hpp"
+#include "utils.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <sys/stat.h>
+
+/*
+ * KEY INDEX - PERSISTENT SIDECAR HASH INDEX FOR ONE COLUMN OF A FILE
+ *
+ * Concept: Remember where each key of a comma-separated file starts, so
+ * a lookup reads one line instead of scanning the file
+ *
+ * Sidecar "<file>.idx<column>":
+ * - Header: magic, version, column, and what the index covers: the data
+ *   file's size and modification time, and a hash of its last 64 bytes
+ * - Table: `capacity` slots of { key hash, line offset + 1 } (0 = empty),
+ *   open addressing with linear probing, at most half full
+ *
+ * Keeping it current (checked on every use):
+ * - Same size and time: the index is used as it is
+ * - File grew and the 64 bytes before the old end are unchanged (and
+ *   end in '\n'): the file was appended to, only the new lines are
+ *   added
+ * - Anything else (rewritten, truncated): the index is rebuilt
+ * The first line with a given key wins, like a front-to-back scan.
+ *
+ * Lookup: hash the key, read the probe window of the sidecar (one
+ * seek), then read the line at each matching offset (one seek) and
+ * compare the column, so hash collisions are never returned.
+ * findMany() maps the data file and loads the table once for a whole
+ * batch of keys.
+ *
+ * Time Complexity:
+ * - Build: O(file size); extend: O(appended bytes + table)
+ * - find: O(1) expected (two seeks)
+ * - findMany: O(table + k) for k keys
+ */
+
+class KeyIndex
+{
+private:
+  static const uint32_t VERSION = 1;
+  static const int TAIL_BYTES = 64;
+  static const int PROBE_WINDOW = 8;    // Slots read per sidecar seek
+
+  struct Header
+  {
+    char magic[8];          // "KEYIDX\r\n"
+    uint32_t version;       // VERSION
+    int32_t column;         // Indexed column (0-based)
+    uint64_t fileSize;      // Bytes of the data file covered
+    int64_t fileTime;       // Modification time of the data file (ns where
+                            // the platform has it, else seconds)
+    uint64_t tailHash;      // Hash of the last TAIL_BYTES covered bytes
+    uint64_t entryCount;    // Keys in the table
+    uint64_t capacity;      // Slots (power of two)
+  };
+
+  struct Slot
+  {
+    uint64_t hash;          // Hash of the key
+    uint64_t offsetPlusOne; // Line offset + 1 (0 = empty slot)
+  };
+
+  // 64-bit FNV-1a
+  static uint64_t hashBytes(const char *bytes, size_t length)
+  {
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < length; i++)
+    {
+      hash ^= static_cast<unsigned char>(bytes[i]);
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  static bool sameMagic(const Header &header)
+  {
+    return std::memcmp(header.magic, "KEYIDX\r\n", 8) == 0 && header.version == VERSION;
+  }
+
+  static bool statFile(const std::string &filename, uint64_t &size, int64_t &time)
+  {
+    struct stat info;
+    if (stat(filename.c_str(), &info) != 0)
+      return false;
+    size = static_cast<uint64_t>(info.st_size);
+#if defined(__linux__)
+    time = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#elif defined(__APPLE__)
+    time = static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+    time = static_cast<int64_t>(info.st_mtime);
+#endif
+    return true;
+  }
+
+  // Hash of the TAIL_BYTES bytes before `end`
+  static uint64_t tailHashOf(const char *data, uint64_t end)
+  {
+    uint64_t start = end > TAIL_BYTES ? end - TAIL_BYTES : 0;
+    return hashBytes(data + start, static_cast<size_t>(end - start));
+  }
+
+  // Column `column` of a line (false = the line has fewer columns)
+  static bool columnOf(std::string_view line, int column, std::string_view &value)
+  {
+    const int MAX_COLUMNS = 100;
+    std::string_view fields[MAX_COLUMNS];
+    if (column < 0 || column >= MAX_COLUMNS)
+      return false;
+
+    if (!line.empty() && line.back() == '\r')
+      line.remove_suffix(1);
+    int count = Utils::splitStringToViews(fields, column + 1, line, ',');
+    if (column >= count)
+      return false;
+    value = fields[column];
+    return true;
+  }
+
+  // Insert unless the key is already present (first line wins)
+  static bool insert(Slot *table, uint64_t capacity, uint64_t hash, uint64_t offset,
+                     std::string_view key, std::string_view file, int column)
+  {
+    uint64_t mask = capacity - 1;
+    for (uint64_t i = hash & mask;; i = (i + 1) & mask)
+    {
+      if (table[i].offsetPlusOne == 0)
+      {
+        table[i].hash = hash;
+        table[i].offsetPlusOne = offset + 1;
+        return true;
+      }
+      if (table[i].hash == hash && keyAt(file, table[i].offsetPlusOne - 1, column) == key)
+        return false;
+    }
+  }
+
+  // Line of a mapped file starting at `offset` (without its '\n')
+  static std::string_view lineAt(std::string_view file, uint64_t offset)
+  {
+    if (offset >= file.size())
+      return std::string_view();
+    size_t end = file.find('\n', static_cast<size_t>(offset));
+    if (end == std::string_view::npos)
+      end = file.size();
+    return file.substr(static_cast<size_t>(offset), end - static_cast<size_t>(offset));
+  }
+
+  // Column value of the line starting at `offset` of a mapped file
+  static std::string_view keyAt(std::string_view file, uint64_t offset, int column)
+  {
+    std::string_view value;
+    columnOf(lineAt(file, offset), column, value);
+    return value;
+  }
+
+  // Read the sidecar header (false = missing or not a key index)
+  static bool readHeader(std::ifstream &in, Header &header)
+  {
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    return static_cast<bool>(in) && sameMagic(header) && header.capacity > 0
+           && (header.capacity & (header.capacity - 1)) == 0;
+  }
+
+  /*
+   * BUILD / EXTEND
+   * Start from the old table when the file was only appended to (else
+   * from an empty one), add the lines after the covered bytes, grow the
+   * table when it gets half full, and write the sidecar through a
+   * temporary file so a reader never sees half of it.
+   */
+  static bool refresh(const std::string &filename, int column)
+  {
+    uint64_t size = 0;
+    int64_t time = 0;
+    if (!statFile(filename, size, time))
+      return false;
+
+    std::string sidecar = sidecarName(filename, column);
+    Header header;
+    Slot *table = nullptr;
+    std::ifstream in(sidecar, std::ios::binary);
+    bool haveOld = in.is_open() && readHeader(in, header) && header.column == column;
+    if (haveOld && header.fileSize == size && header.fileTime == time)
+      return true;
+
+    MappedFile file;
+    if (!file.open(filename))
+      return false;
+    const char *data = file.bytes();
+    size = file.length();
+    std::string_view contents(data, static_cast<size_t>(size));
+
+    // Appended to: the old end is still a line end with the same bytes
+    uint64_t start = 0;
+    if (haveOld && size > header.fileSize && header.fileSize > 0 && data[header.fileSize - 1] == '\n'
+        && tailHashOf(data, header.fileSize) == header.tailHash)
+    {
+      table = new Slot[header.capacity];
+      in.read(reinterpret_cast<char *>(table), static_cast<std::streamsize>(header.capacity * sizeof(Slot)));
+      if (in)
+        start = header.fileSize;
+      else
+      {
+        delete[] table;
+        table = nullptr;
+      }
+    }
+    in.close();
+
+    if (table == nullptr)
+    {
+      std::memcpy(header.magic, "KEYIDX\r\n", 8);
+      header.version = VERSION;
+      header.column = column;
+      header.entryCount = 0;
+      header.capacity = 64;
+      table = new Slot[header.capacity]();
+    }
+
+    // The newline scan keeps line starts in order
+    uint64_t lineStart = start;
+    auto addLine = [&](uint64_t lineEnd) {
+      std::string_view key;
+      if (lineEnd > lineStart && columnOf(std::string_view(data + lineStart, lineEnd - lineStart), column, key))
+      {
+        if ((header.entryCount + 1) * 2 > header.capacity)
+          table = grow(table, header.capacity);
+        if (insert(table, header.capacity, hashBytes(key.data(), key.size()), lineStart, key, contents, column))
+          header.entryCount++;
+      }
+      lineStart = lineEnd + 1;
+    };
+    Utils::forEachByte(data + start, static_cast<size_t>(size - start), '\n',
+                       [&](size_t position) { addLine(start + position); });
+    if (lineStart < size)
+      addLine(size);
+
+    header.fileSize = size;
+    header.fileTime = time;
+    header.tailHash = tailHashOf(data, size);
+
+    std::string temporary = sidecar + ".tmp";
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    bool written = false;
+    if (out.is_open())
+    {
+      out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      out.write(reinterpret_cast<const char *>(table), static_cast<std::streamsize>(header.capacity * sizeof(Slot)));
+      out.close();
+#ifdef _WIN32
+      std::remove(sidecar.c_str());
+#endif
+      written = !out.fail() && std::rename(temporary.c_str(), sidecar.c_str()) == 0;
+    }
+
+    delete[] table;
+    return written;
+  }
+
+  // Double the table and re-insert every entry
+  static Slot *grow(Slot *table, uint64_t &capacity)
+  {
+    uint64_t newCapacity = capacity * 2;
+    Slot *bigger = new Slot[newCapacity]();
+    for (uint64_t i = 0; i < capacity; i++)
+    {
+      if (table[i].offsetPlusOne == 0)
+        continue;
+      uint64_t mask = newCapacity - 1;
+      uint64_t j = table[i].hash & mask;
+      while (bigger[j].offsetPlusOne != 0)
+        j = (j + 1) & mask;
+      bigger[j] = table[i];
+    }
+    delete[] table;
+    capacity = newCapacity;
+    return bigger;
+  }
+
+public:
+  // Sidecar file of `filename` for `column`
+  static std::string sidecarName(const std::string &filename, int column)
+  {
+    return filename + ".idx" + std::to_string(column);
+  }
+
+  // Drop the sidecar (the next lookup rebuilds it)
+  static void invalidate(const std::string &filename, int column)
+  {
+    std::remove(sidecarName(filename, column).c_str());
+  }
+
+  // First line whose column `column` equals `key` (1 = found, 0 = no
+  // such line, -1 = the data file or its index could not be read)
+  static int find(const std::string &filename, std::string_view key, int column, std::string &line)
+  {
+    if (!refresh(filename, column))
+      return -1;
+
+    std::ifstream index(sidecarName(filename, column), std::ios::binary);
+    std::ifstream in(filename, std::ios::binary);
+    Header header;
+    if (!in.is_open() || !index.is_open() || !readHeader(index, header))
+      return -1;
+
+    uint64_t hash = hashBytes(key.data(), key.size());
+    uint64_t mask = header.capacity - 1;
+    uint64_t slot = hash & mask;
+    Slot window[PROBE_WINDOW];
+
+    // The table is at most half full, so an empty slot always comes
+    for (;;)
+    {
+      uint64_t run = header.capacity - slot < PROBE_WINDOW ? header.capacity - slot : PROBE_WINDOW;
+      index.seekg(static_cast<std::streamoff>(sizeof(Header) + slot * sizeof(Slot)));
+      index.read(reinterpret_cast<char *>(window), static_cast<std::streamsize>(run * sizeof(Slot)));
+      if (!index)
+        return -1;
+
+      for (uint64_t i = 0; i < run; i++)
+      {
+        if (window[i].offsetPlusOne == 0)
+          return 0;
+        if (window[i].hash != hash)
+          continue;
+
+        in.seekg(static_cast<std::streamoff>(window[i].offsetPlusOne - 1));
+        std::string candidate;
+        std::string_view value;
+        if (std::getline(in, candidate) && columnOf(candidate, column, value) && value == key)
+        {
+          if (!candidate.empty() && candidate.back() == '\r')
+            candidate.pop_back();
+          line = candidate;
+          return 1;
+        }
+        in.clear();
+      }
+      slot = (slot + run) & mask;
+    }
+  }
+
+  // Look up `count` keys at once: lines[i] gets the line of keys[i] or
+  // "" (returns how many were found)
+  static int findMany(const std::string &filename, const std::string keys[], int count, int column,
+                      std::string lines[])
+  {
+    for (int i = 0; i < count; i++)
+      lines[i].clear();
+    if (!refresh(filename, column))
+      return 0;
+
+    std::ifstream index(sidecarName(filename, column), std::ios::binary);
+    Header header;
+    MappedFile file;
+    if (!index.is_open() || !readHeader(index, header) || !file.open(filename))
+      return 0;
+
+    Slot *table = new Slot[header.capacity];
+    index.read(reinterpret_cast<char *>(table), static_cast<std::streamsize>(header.capacity * sizeof(Slot)));
+    if (!index)
+    {
+      delete[] table;
+      return 0;
+    }
+
+    std::string_view contents(file.bytes(), file.length());
+    uint64_t mask = header.capacity - 1;
+    int found = 0;
+    for (int k = 0; k < count; k++)
+    {
+      uint64_t hash = hashBytes(keys[k].data(), keys[k].size());
+      for (uint64_t i = hash & mask; table[i].offsetPlusOne != 0; i = (i + 1) & mask)
+      {
+        uint64_t offset = table[i].offsetPlusOne - 1;
+        if (table[i].hash != hash || keyAt(contents, offset, column) != keys[k])
+          continue;
+
+        std::string_view line = lineAt(contents, offset);
+        if (!line.empty() && line.back() == '\r')
+          line.remove_suffix(1);
+        lines[k].assign(line.data(), line.size());
+        found++;
+        break;
+      }
+    }
+
+    delete[] table;
+    return found;
+  }
+};
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef LOAD_PROGRESS_HPP
+#define LOAD_PROGRESS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <istream>
+#include <string>
+
+/*
+ * LOAD PROGRESS - PROGRESS BAR FOR SINGLE-PASS FILE LOADERS
+ *
+ * Concept: The loader reads the file once and reports how many bytes it
+ * has consumed so far; the fraction done is bytes read / file size, so
+ * no line-counting pre-pass is needed
+ *
+ * - update() is cheap to call for every record: the bar is only redrawn
+ *   when REDRAW_MS milliseconds have passed since the last redraw
+ * - finish() draws the full bar and reports records/s and MB/s
+ *
+ * Time Complexity:
+ * - update: O(1) (one clock read, a redraw at most every REDRAW_MS)
+ * - finish: O(1)
+ */
+
+class LoadProgress
+{
+private:
+    static constexpr int BAR_WIDTH = 30;
+    static constexpr int REDRAW_MS = 100; // At most 10 redraws per second
+
+    typedef std::chrono::steady_clock Clock;
+
+    uint64_t totalBytes;          // File size (0 = unknown)
+    Clock::time_point start;      // When loading started
+    Clock::time_point lastDraw;   // Last redraw of the bar
+    int spinIndex;                // Spinner frame
+
+    void draw(uint64_t bytesRead)
+    {
+        static const char *const spinner[] = {"⠋", "⠙", "⠹", "⠸", "⠼", "⠴", "⠦", "⠧", "⠇", "⠏"};
+
+        int percent = 0;
+        if (totalBytes > 0)
+            percent = static_cast<int>(bytesRead >= totalBytes ? 100 : bytesRead * 100 / totalBytes);
+        int filled = percent * BAR_WIDTH / 100;
+
+        std::string bar;
+        for (int i = 0; i < BAR_WIDTH; ++i)
+            bar += i < filled ? "█" : " ";
+
+        std::cout << "\r\033[1m\033[32m" << spinner[spinIndex % 10] << " [" << bar << "] "
+                  << std::setw(3) << percent << "% \033[0m";
+        std::cout.flush();
+        spinIndex++;
+    }
+
+public:
+    explicit LoadProgress(uint64_t fileBytes)
+        : totalBytes(fileBytes), start(Clock::now()), lastDraw(start), spinIndex(0)
+    {
+    }
+
+    // Size of an open file (the read position is left at the start)
+    static uint64_t fileSize(std::istream &file)
+    {
+        file.seekg(0, std::ios::end);
+        std::streamoff size = file.tellg();
+        file.seekg(0, std::ios::beg);
+        return size > 0 ? static_cast<uint64_t>(size) : 0;
+    }
+
+    // `bytesRead` bytes of the file have been consumed
+    void update(uint64_t bytesRead)
+    {
+        Clock::time_point now = Clock::now();
+        if (now - lastDraw < std::chrono::milliseconds(REDRAW_MS))
+            return;
+
+        lastDraw = now;
+        draw(bytesRead);
+    }
+
+    // Draw the full bar and report the load rate
+    void finish(uint64_t records, uint64_t bytesRead)
+    {
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (seconds < 1e-6)
+            seconds = 1e-6;
+
+        std::ios::fmtflags flags = std::cout.flags();
+        std::streamsize precision = std::cout.precision();
+
+        std::cout << "\r\033[1m\033[32m✅ [██████████████████████████████] 100%\033[0m\n"
+                  << std::fixed << std::setprecision(1)
+                  << "   " << records << " records, " << bytesRead / 1024.0 / 1024.0 << " MB in "
+                  << seconds * 1000.0 << " ms (" << std::setprecision(0) << records / seconds
+                  << " records/s, " << std::setprecision(1) << bytesRead / 1024.0 / 1024.0 / seconds
+                  << " MB/s)" << std::endl;
+
+        std::cout.flags(flags);
+        std::cout.precision(precision);
+    }
+};
+
+#endif
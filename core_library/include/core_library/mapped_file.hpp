@@ -0,0 +1,191 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include "utils.hpp"
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <string_view>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * MAPPED FILE - READ-ONLY FILE MAPPING WITH A LINE INDEX
+ *
+ * Concept: Map the whole file into memory instead of copying it line
+ * by line into strings
+ * - open() maps the file read-only (where mmap is missing, the file is
+ *   read into one buffer instead)
+ * - indexLines() finds every '\n' once with Utils::forEachByte (16/32
+ *   bytes per step) and keeps the offset of each line end
+ * - line(i) is then a string_view into the mapping: random access by
+ *   line number, no allocation, no row count stored anywhere else
+ *
+ * Line end table (n = number of lines):
+ *   lineEnds[i] = offset of the '\n' ending line i (file length for a
+ *                 last line without one)
+ *   line i = [lineEnds[i - 1] + 1, lineEnds[i]), a trailing '\r' cut off
+ *
+ * Views stay valid until the file is closed.
+ *
+ * Time Complexity:
+ * - open: O(1) mapped (pages are read on first touch)
+ * - indexLines: O(file size / block size + lines)
+ * - line(i): O(1)
+ */
+
+class MappedFile
+{
+private:
+  const char *data;     // First byte of the file
+  size_t size;          // File length in bytes
+  bool mapped;          // true = mmap, false = heap buffer
+  bool opened;          // A file is open (possibly empty)
+  size_t *lineEnds;     // End offset of every line (see above)
+  int lineCount;        // Lines in the index (-1 = not indexed)
+
+  MappedFile(const MappedFile &);
+  MappedFile &operator=(const MappedFile &);
+
+public:
+  MappedFile() : data(nullptr), size(0), mapped(false), opened(false), lineEnds(nullptr), lineCount(-1) {}
+
+  ~MappedFile() { close(); }
+
+  // Map `filename` read-only (false = missing or unreadable; an empty
+  // file opens with no lines)
+  bool open(const std::string &filename)
+  {
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+      ::close(fd);
+      return false;
+    }
+
+    size = static_cast<size_t>(info.st_size);
+    if (size > 0)
+    {
+      void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (address == MAP_FAILED)
+      {
+        ::close(fd);
+        size = 0;
+        return false;
+      }
+      data = static_cast<const char *>(address);
+      mapped = true;
+    }
+    ::close(fd);
+    opened = true;
+    return true;
+#else
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+      return false;
+
+    std::streamoff length = file.tellg();
+    size = length > 0 ? static_cast<size_t>(length) : 0;
+    if (size > 0)
+    {
+      char *buffer = new char[size];
+      file.seekg(0, std::ios::beg);
+      file.read(buffer, static_cast<std::streamsize>(size));
+      data = buffer;
+      if (!file)
+      {
+        close();
+        return false;
+      }
+    }
+    opened = true;
+    return true;
+#endif
+  }
+
+  // Unmap the file and drop the line index
+  void close()
+  {
+#ifndef _WIN32
+    if (mapped)
+      munmap(const_cast<char *>(data), size);
+    else
+#endif
+      delete[] data;
+
+    delete[] lineEnds;
+    data = nullptr;
+    size = 0;
+    mapped = false;
+    opened = false;
+    lineEnds = nullptr;
+    lineCount = -1;
+  }
+
+  // The pages will be read front to back once (more read-ahead)
+  void adviseSequential() const
+  {
+#ifndef _WIN32
+    if (mapped)
+      madvise(const_cast<char *>(data), size, MADV_SEQUENTIAL);
+#endif
+  }
+
+  bool isOpen() const { return opened; }
+  const char *bytes() const { return data; }
+  size_t length() const { return size; }
+
+  // Build the line end table (returns the number of lines)
+  int indexLines()
+  {
+    if (lineCount >= 0)
+      return lineCount;
+
+    // Pass 1 counts the newlines to size the table, pass 2 fills it
+    int newlines = 0;
+    Utils::forEachByte(data, size, '\n', [&](size_t) { newlines++; });
+
+    bool unterminated = size > 0 && data[size - 1] != '\n';
+    lineEnds = new size_t[newlines + (unterminated ? 1 : 0) + 1];
+
+    int count = 0;
+    Utils::forEachByte(data, size, '\n', [&](size_t position) { lineEnds[count++] = position; });
+    if (unterminated)
+      lineEnds[count++] = size;
+
+    lineCount = count;
+    return lineCount;
+  }
+
+  // Lines in the index (indexLines() must have run)
+  int getLineCount() const { return lineCount < 0 ? 0 : lineCount; }
+
+  // Line `index` without its line break (0 <= index < getLineCount())
+  std::string_view line(int index) const
+  {
+    size_t start = index == 0 ? 0 : lineEnds[index - 1] + 1;
+    size_t end = lineEnds[index];
+    if (end > start && data[end - 1] == '\r')
+      end--;
+    return std::string_view(data + start, end - start);
+  }
+
+  // Offset just past line `index` (for progress by bytes)
+  size_t lineEndOffset(int index) const
+  {
+    return lineEnds[index] < size ? lineEnds[index] + 1 : size;
+  }
+};
+
+#endif
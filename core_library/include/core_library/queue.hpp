@@ -1,4 +1,6 @@
 #include "FileIO.hpp"
+#include "mapped_file.hpp"
+#include "record_parser.hpp"
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -23,13 +25,23 @@ struct Patient {
     return patientID + "," + name + "," + conditionType;
   }
 
+  // TXT layout: patientID,name,conditionType
+  typedef RecordSchema<Patient, TextField<&Patient::patientID>,
+                       TextField<&Patient::name>,
+                       TextField<&Patient::conditionType>>
+      Schema;
+
+  // Parse TXT line into an existing Patient (false = malformed line)
+  static bool parseTXT(std::string_view line, Patient &p,
+                       RecordError &error) {
+    return Schema::parse(line, p, error);
+  }
+
   // Parse TXT line to create Patient object
   static Patient fromTXT(const std::string &line) {
     Patient p;
-    std::stringstream ss(line);
-    std::getline(ss, p.patientID, ',');
-    std::getline(ss, p.name, ',');
-    std::getline(ss, p.conditionType, ',');
+    RecordError error;
+    Schema::parse(line, p, error);
     return p;
   }
 };
@@ -44,12 +56,11 @@ private:
   int count;                     // Current number of patients in queue
   std::string filename;          // File to persist patient data
 
-  // Load patients from file during initialization using FileIO
+  // Load patients from file during initialization (the file is mapped
+  // and each line parsed from a view into it)
   void loadFromFile() {
-    std::string lines[MAX_SIZE];
-    int linesRead = FileIO::readFromFile(filename, lines, MAX_SIZE);
-
-    if (linesRead == -1) {
+    MappedFile file;
+    if (!file.open(filename)) {
       // File doesn't exist yet, start with empty queue
       return;
     }
@@ -58,11 +69,20 @@ private:
     frontIndex = 0;
     rearIndex = -1;
 
-    // Parse each line and add to queue
-    for (int i = 0; i < linesRead; i++) {
-      if (!lines[i].empty()) {
-        rearIndex = (rearIndex + 1) % MAX_SIZE;
-        patients[rearIndex] = Patient::fromTXT(lines[i]);
+    // Parse each line and add to queue (malformed lines are skipped)
+    int lineCount = file.indexLines();
+    for (int i = 0; i < lineCount && count < MAX_SIZE; i++) {
+      std::string_view line = file.line(i);
+      if (!line.empty()) {
+        RecordError error;
+        int slot = (rearIndex + 1) % MAX_SIZE;
+        if (!Patient::parseTXT(line, patients[slot], error)) {
+          std::cout << "Warning: skipped line " << (i + 1) << " of "
+                    << filename << " (field " << (error.field + 1) << " "
+                    << error.reason << ").\n";
+          continue;
+        }
+        rearIndex = slot;
         count++;
       }
     }
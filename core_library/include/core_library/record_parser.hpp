@@ -0,0 +1,142 @@
+#ifndef RECORD_PARSER_HPP
+#define RECORD_PARSER_HPP
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/*
+ * RECORD PARSER - SCHEMA-DRIVEN PARSING OF COMMA-SEPARATED DATA LINES
+ *
+ * Concept: Each record type lists its fields once, at compile time, and
+ * one routine walks the line in place to fill them
+ *
+ *   typedef RecordSchema<SupplyItem,
+ *                        TextField<&SupplyItem::id>,
+ *                        TextField<&SupplyItem::type>,
+ *                        IntField<&SupplyItem::quantity, 0, 1000000000>,
+ *                        TextField<&SupplyItem::batch>> SupplyItemSchema;
+ *
+ *   RecordError error;
+ *   if (!SupplyItemSchema::parse(line, item, error)) ... report error
+ *
+ * - The line is a string_view, tokens are views into it (no copies)
+ * - TextField copies its token into a std::string member; assign()
+ *   reuses the member's buffer, so a record reused across lines
+ *   allocates only when a field outgrows it
+ * - IntField converts with std::from_chars (no locale, no exceptions)
+ *   and checks the range, then stores into an int or enum member
+ * - SkipField accepts any token and keeps nothing
+ * - Too few fields, a bad number or an out-of-range value makes parse()
+ *   return false with the field index and a reason; nothing throws.
+ *   Fields after the last one in the schema are ignored.
+ *
+ * Time Complexity: O(line length), one pass
+ */
+
+// Why a line was rejected
+struct RecordError
+{
+  int field;            // Index of the offending field (0-based)
+  const char *reason;   // "missing field", "not a number", "out of range"
+
+  RecordError() : field(-1), reason("") {}
+};
+
+// Field kept as text
+template <auto Member>
+struct TextField
+{
+  template <typename Record>
+  static bool apply(Record &record, std::string_view token, const char *&)
+  {
+    (record.*Member).assign(token.data(), token.size());
+    return true;
+  }
+};
+
+// Whole-number field in [Min, Max] (the member may be an int or an enum)
+template <auto Member, long long Min, long long Max>
+struct IntField
+{
+  template <typename Record>
+  static bool apply(Record &record, std::string_view token, const char *&reason)
+  {
+    long long value = 0;
+    const char *end = token.data() + token.size();
+    std::from_chars_result result = std::from_chars(token.data(), end, value);
+    if (token.empty() || result.ec == std::errc::invalid_argument || result.ptr != end)
+    {
+      reason = "not a number";
+      return false;
+    }
+    if (result.ec == std::errc::result_out_of_range || value < Min || value > Max)
+    {
+      reason = "out of range";
+      return false;
+    }
+
+    typedef typename std::remove_reference<decltype(record.*Member)>::type Value;
+    record.*Member = static_cast<Value>(value);
+    return true;
+  }
+};
+
+// Field present in the file but not kept
+struct SkipField
+{
+  template <typename Record>
+  static bool apply(Record &, std::string_view, const char *&)
+  {
+    return true;
+  }
+};
+
+template <typename Record, typename... Fields>
+struct RecordSchema
+{
+  static const int FIELD_COUNT = sizeof...(Fields);
+
+  // Fill `record` from one line (false = malformed, see `error`)
+  static bool parse(std::string_view line, Record &record, RecordError &error)
+  {
+    if (!line.empty() && line.back() == '\r')
+      line.remove_suffix(1);
+
+    size_t position = 0;
+    int field = 0;
+    return (next<Fields>(line, position, field, record, error) && ...);
+  }
+
+private:
+  // Cut the next token off the line and hand it to field type F
+  template <typename F>
+  static bool next(std::string_view line, size_t &position, int &field, Record &record, RecordError &error)
+  {
+    if (position > line.size())
+    {
+      error.field = field;
+      error.reason = "missing field";
+      return false;
+    }
+
+    size_t comma = line.find(',', position);
+    if (comma == std::string_view::npos)
+      comma = line.size();
+
+    const char *reason = "";
+    if (!F::apply(record, line.substr(position, comma - position), reason))
+    {
+      error.field = field;
+      error.reason = reason;
+      return false;
+    }
+
+    position = comma + 1;
+    field++;
+    return true;
+  }
+};
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef SHIFTROSTER_HPP
+#define SHIFTROSTER_HPP
+
+#include "circular_queue.hpp"
+
+/*
+ * SHIFT ROSTER - ROTATION SCHEDULE DERIVED FROM ONE ORIGIN
+ *
+ * Concept: The ambulances take their shifts in queue order, back to
+ * back, over and over. Instead of storing every vehicle's next date and
+ * times (and rewriting all of them on each rotation), the roster keeps
+ * one origin and every ambulance keeps its place in the cycle:
+ *
+ *   cycle          = one full turn of the rotation (sum of shift lengths)
+ *   shiftOffset(v) = minutes from the start of a cycle to v's shift
+ *   frontStart     = schedule minute the front's current shift starts
+ *
+ *   shift of the ambulance at position i (0 = front):
+ *     start = frontStart + (shiftOffset(i) - shiftOffset(front)) mod cycle
+ *     end   = start + shiftMinutes(i)
+ *
+ * - Normal rotation: frontStart moves on to the new front's start
+ * - Dynamic rotation: frontStart = now; everyone behind follows
+ * - Registration: the new ambulance goes at the end of the cycle
+ * - Ambulance::shiftStart is only a copy, written by materialize() for
+ *   the positions about to be shown or saved
+ *
+ * Re-basing (offsets recomputed from the front) costs O(n); it is only
+ * needed when a shift length changes or when an ambulance registers
+ * while the front is not the first shift of the cycle.
+ *
+ * Planning queries (who covers minute T, the shifts in [T1, T2), the
+ * next shift of one ambulance) look ahead assuming every later rotation
+ * is a normal one. The schedule then has two closed-form phases:
+ *
+ *   turn 0   [frontStart, frontStart + cycle): everyone's next shift,
+ *            at the offsets and lengths above
+ *   turn 1+  from planStart = frontStart + cycle: standard shifts in
+ *            queue order, repeating every period = n * standardMinutes
+ *              start(i, turn) = planStart + (turn - 1) * period + i * standard
+ *
+ * (a rotated ambulance always comes back with the standard length), so
+ * any date weeks ahead is one division away; nothing is materialized.
+ *
+ * Time Complexity:
+ * - shiftAt: O(1)
+ * - rotated, restart: O(1) (O(n) re-base after a shift length change)
+ * - append: O(1) (O(n) re-base on the first one after rotations)
+ * - materialize: O(count)
+ * - rebuild, load: O(n)
+ * - coveringPosition: O(1) (O(log n) inside turn 0 when shift lengths
+ *   differ: binary search over the offsets)
+ * - nextShiftOf: O(1)
+ * - forEachShift: O(k) for k shifts, after one coveringPosition
+ */
+
+// One shift, in schedule minutes (see toScheduleMinute)
+struct Shift
+{
+    long long start;   // -1 = not scheduled
+    long long end;
+};
+
+class ShiftRoster
+{
+private:
+    long long frontStart;     // Start of the front's current shift (-1 = no schedule)
+    long long cycleMinutes;   // One full turn of the rotation
+    int standardMinutes;      // Length given to new and re-timed shifts
+    bool uniform;             // Every shift is standardMinutes long, back to back
+
+    long long relativeOffset(const CircularQueue &queue, int position) const;
+
+    void rebase(CircularQueue &queue, int count);
+
+    int firstShiftFrom(const CircularQueue &queue, long long minute, Shift &shift) const;
+
+    int nextPlanned(const CircularQueue &queue, int position, Shift &shift) const;
+
+public:
+    ShiftRoster();
+
+    /* Helper */
+    bool isScheduled() const;
+
+    int getStandardMinutes() const;
+
+    // Later shifts (new and rotated ambulances) get this length
+    void setStandardMinutes(int minutes);
+
+    /* Schedule */
+    // Shift of the ambulance at `position` (0 = front)
+    Shift shiftAt(const CircularQueue &queue, int position) const;
+
+    // Write shiftStart of the ambulances at [first, first + count)
+    void materialize(CircularQueue &queue, int first, int count) const;
+
+    // The rear ambulance was just enqueued: give it the next free shift
+    // (the very first ambulance starts at `now`)
+    void append(CircularQueue &queue, long long now);
+
+    // The queue was just rotated (or, with one ambulance, its shift is
+    // over): the new front takes over where its shift was planned
+    void rotated(CircularQueue &queue);
+
+    // Dynamic rotation: the front starts a fresh shift at `minute`
+    void restart(CircularQueue &queue, long long minute);
+
+    // Back-to-back standard shifts for everyone, the front starting at `start`
+    void rebuild(CircularQueue &queue, long long start);
+
+    // Take the schedule over from the loaded ambulances: the front's
+    // shiftStart plus each one's shiftMinutes
+    void load(CircularQueue &queue);
+
+    /* Planning (later rotations assumed normal) */
+    // Position of the ambulance on duty at `minute` and that shift
+    // (-1 = no schedule, or `minute` is before the current shift)
+    int coveringPosition(const CircularQueue &queue, long long minute, Shift &shift) const;
+
+    // First shift of the ambulance at `position` that is still running
+    // or starts after `minute` (start -1 = no schedule)
+    Shift nextShiftOf(const CircularQueue &queue, int position, long long minute) const;
+
+    // visit(ambulance, shift) for every shift overlapping [from, to), in
+    // time order; returns how many were visited
+    template <typename Visitor>
+    int forEachShift(const CircularQueue &queue, long long from, long long to, Visitor visit) const
+    {
+        int count = 0;
+        Shift shift;
+        int position = from < to ? firstShiftFrom(queue, from, shift) : -1;
+
+        while (position >= 0 && shift.start < to)
+        {
+            visit(queue.at(position), shift);
+            count++;
+            position = nextPlanned(queue, position, shift);
+        }
+        return count;
+    }
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define STACK_HPP
 
 #include "FileIO.hpp"
+#include "mapped_file.hpp"
 #include "supply_item.hpp"
 #include <iostream>
 #include <stdexcept>
@@ -87,32 +88,32 @@ public:
     }
   }
 
+  // Push every item of the supply file (mapped; lines are parsed from
+  // views into the mapping, the count header line is skipped)
   void loadDataIntoStack()
   {
-    int rowCount = FileIO::getFileCount("supplyitem");
-    if (rowCount <= 0)
+    MappedFile file;
+    if (!file.open("../core_library/include/data/supply_item.txt"))
       return;
 
-    std::string *readBuffer = new std::string[rowCount];
-    FileIO::readFromFile("../core_library/include/data/supply_item.txt", readBuffer, rowCount);
-
-    for (int i = 0; i < rowCount; ++i)
+    // Every field is parsed in place into one reused item
+    T item;
+    int lineCount = file.indexLines();
+    for (int i = 0; i < lineCount; ++i)
     {
-      const std::string &line = readBuffer[i];
-
-      const int tempLimit = 4;
-      std::string tempArr[tempLimit];
+      std::string_view line = file.line(i);
+      if (line.empty() || (i == 0 && FileIO::isCountHeader(line)))
+        continue;
 
-      int fieldCount = Utils::splitStringToArr(tempArr, tempLimit, line, ",");
-      if (fieldCount == tempLimit)
+      RecordError error;
+      if (!T::Schema::parse(line, item, error))
       {
-        int qty = std::stoi(tempArr[2]);
-        SupplyItem item(tempArr[0], tempArr[1], qty, tempArr[3]);
-        this->push(item);
+        cout << "Warning: skipped supply item line " << (i + 1) << " (field "
+             << (error.field + 1) << " " << error.reason << ")." << endl;
+        continue;
       }
+      this->push(item);
     }
-
-    delete[] readBuffer;
   }
 
   void pushItemsIntoStack(T *arr, size_t size)
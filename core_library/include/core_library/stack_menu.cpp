@@ -10,7 +10,7 @@ void addItems() {
   int itemIndex = 0;
   SupplyItem* temp = new SupplyItem[maxSize];
   std::string batchId;
-  int id = FileIO::getFileCount("supplyitem");
+  int id = FileIO::getRecordCount("../core_library/include/data/supply_item.txt");
   std::string testInput;
   bool isContinue = true;
 
@@ -47,8 +47,7 @@ void addItems() {
     if (!testInput.empty()) {
       std::cout << "Loading into stack..." << std::endl;
       itemStack.pushItemsIntoStack(temp, itemIndex);
-      FileIO::appendObjectsToFile("../core_library/include/data/supply_item.txt", temp, itemIndex);
-      FileIO::updateFileCount("supplyitem", id);
+      FileIO::appendRecordsToFile("../core_library/include/data/supply_item.txt", temp, itemIndex);
 
       isContinue = false;
     }
@@ -71,11 +70,9 @@ void useLastAddedItem() {
   std::cout << "This is the last item, do you want to use it? (press enter to confirm)" << std::endl;
   std::getline(std::cin, test);
   if (test.empty()) {
-    int id = FileIO::getFileCount("supplyitem");
     itemStack.pop();
-    // update text file, update index file
-    FileIO::removeLastLineFromFile("../core_library/include/data/supply_item.txt");
-    FileIO::updateFileCount("supplyitem", --id);
+    // drop the last line and lower the count in the file header
+    FileIO::popRecordFromFile("../core_library/include/data/supply_item.txt");
   }
 }
 
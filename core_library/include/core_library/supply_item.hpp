@@ -6,6 +6,7 @@
 #include <iomanip>
 #include <sstream>
 #include "FileIO.hpp"
+#include "record_parser.hpp"
 
 struct SupplyItem {
   std::string id;
@@ -15,6 +16,13 @@ struct SupplyItem {
 
   static const int MAX_LINES = 1000;
 
+  // File layout: id,type,quantity,batch
+  typedef RecordSchema<SupplyItem, TextField<&SupplyItem::id>,
+                       TextField<&SupplyItem::type>,
+                       IntField<&SupplyItem::quantity, 0, 2147483647>,
+                       TextField<&SupplyItem::batch>>
+      Schema;
+
   SupplyItem() : id(""), type(""), quantity(0), batch("") {}
   SupplyItem(std::string id, std::string type, int quantity, std::string batch) {
     // this->id = "SI" + id;
@@ -3,15 +3,17 @@
 #include <iomanip>
 #include <ctime>
 #include <sstream>
+#include <charconv>
+#include <cstdio>
 using namespace std;
 
 void Ambulance::display() const
 {
     // Color coding based on status
     string statusColor;
-    if (status == "On Duty")
+    if (status == AmbulanceStatus::OnDuty)
         statusColor = "\033[32m"; // Green - On Duty
-    else if (status == "Standby")
+    else if (status == AmbulanceStatus::Standby)
         statusColor = "\033[33m"; // Yellow - Standby
     else
         statusColor = "\033[31m"; // Red - Off Duty
@@ -19,10 +21,10 @@ void Ambulance::display() const
     cout << left << setw(12) << vehicleID
          << setw(15) << ambulanceID
          << setw(20) << driverName
-         << statusColor << setw(12) << status << "\033[0m"
-         << setw(16) << scheduleDate
-         << setw(12) << shiftStartTime
-         << setw(12) << shiftEndTime;
+         << statusColor << setw(12) << statusName(status) << "\033[0m"
+         << setw(16) << formatScheduleDate(shiftStart)
+         << setw(12) << formatScheduleTime(shiftStart)
+         << setw(12) << formatScheduleTime(shiftEnd());
 
     int duration = getShiftDurationHours();
     cout << setw(10) << (duration > 0 ? to_string(duration) + " hrs" : "-") << endl;
@@ -31,32 +33,30 @@ void Ambulance::display() const
 // Calculate shift duration in hours
 int Ambulance::getShiftDurationHours() const
 {
-    if (shiftStartTime == "--:--" || shiftEndTime == "--:--")
+    if (shiftStart < 0)
     {
         return 0;
     }
-    return calculateTimeDifference(shiftStartTime, shiftEndTime);
+    return shiftMinutes / 60;
 }
 
-// Active shift check
+// Active shift check (also right across midnight)
 bool Ambulance::isShiftActive() const
 {
-    if (shiftStartTime == "--:--" || shiftEndTime == "--:--")
+    if (shiftStart < 0)
     {
         return false;
     }
 
-    string currentTime = getCurrentTimeString();
-
-    // Same day comparison
-    return (currentTime >= shiftStartTime && currentTime < shiftEndTime);
+    long long now = currentScheduleMinute();
+    return now >= shiftStart && now < shiftEnd();
 }
 
-// Generate shift times based on start time and duration
-void Ambulance::generateShiftTimes(string startTime, int durationHours)
+// Set the shift from its start and duration
+void Ambulance::generateShiftTimes(long long start, int durationHours)
 {
-    shiftStartTime = startTime;
-    shiftEndTime = addHoursToTime(startTime, durationHours);
+    shiftStart = start;
+    shiftMinutes = durationHours * 60;
 }
 
 // Get current time in HH:MM format (static to avoid duplicate symbol)
@@ -96,90 +96,154 @@ string getDayOfWeek()
     return days[localTime->tm_wday];
 }
 
-// Add hours to datetime (handles day transition)
-void addHoursToDateTime(string &date, string &time, int hours)
+/* Schedule minutes */
+
+// Days from 1970-01-01 to a civil date (proleptic Gregorian calendar)
+static long long daysFromCivil(int year, int month, int day)
 {
-    int hour = stoi(time.substr(0, 2));
-    int minute = stoi(time.substr(3, 2));
+    year -= month <= 2;
+    long long era = (year >= 0 ? year : year - 399) / 400;
+    int yearOfEra = year - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
 
-    hour += hours;
+// Civil date of a day count from 1970-01-01 (inverse of daysFromCivil)
+static void civilFromDays(long long days, int &year, int &month, int &day)
+{
+    days += 719468;
+    long long era = (days >= 0 ? days : days - 146096) / 146097;
+    int dayOfEra = static_cast<int>(days - era * 146097);
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int monthIndex = (5 * dayOfYear + 2) / 153;
+
+    day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    year = static_cast<int>(yearOfEra + era * 400) + (month <= 2);
+}
 
-    // Calculate days to add
-    int daysToAdd = hour / 24;
-    hour = hour % 24;
+// Read `count` digits at `text` (false = not all digits)
+static bool readDigits(string_view text, size_t at, size_t count, int &value)
+{
+    if (at + count > text.size())
+        return false;
 
-    stringstream ss;
-    ss << setfill('0') << setw(2) << hour << ":"
-       << setfill('0') << setw(2) << minute;
-    time = ss.str();
+    const char *first = text.data() + at;
+    from_chars_result result = from_chars(first, first + count, value);
+    return result.ec == errc() && result.ptr == first + count;
+}
 
-    if (daysToAdd > 0)
+// "YYYY-MM-DD" -> schedule minute of its midnight (-1 = "--" or malformed)
+long long parseScheduleDate(string_view date)
+{
+    int year, month, day;
+    if (date.size() != 10 || date[4] != '-' || date[7] != '-' ||
+        !readDigits(date, 0, 4, year) || !readDigits(date, 5, 2, month) || !readDigits(date, 8, 2, day) ||
+        month < 1 || month > 12 || day < 1 || day > 31)
     {
-        // Parse date (YYYY-MM-DD)
-        int year = stoi(date.substr(0, 4));
-        int month = stoi(date.substr(5, 2));
-        int day = stoi(date.substr(8, 2));
-
-        day += daysToAdd;
-
-        // Date Increment
-        int daysInMonth[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-        while (day > daysInMonth[month - 1])
-        {
-            day -= daysInMonth[month - 1];
-            month++;
-            if (month > 12)
-            {
-                month = 1;
-                year++;
-            }
-        }
-
-        stringstream dateStream;
-        dateStream << year << "-"
-                   << setfill('0') << setw(2) << month << "-"
-                   << setfill('0') << setw(2) << day;
-        date = dateStream.str();
+        return -1;
     }
+
+    return daysFromCivil(year, month, day) * 1440;
 }
 
-/* Helper */
+// "HH:MM" -> minutes since midnight (-1 = "--:--" or malformed)
+int parseClockTime(string_view time)
+{
+    int hour, minute;
+    if (time.size() != 5 || time[2] != ':' ||
+        !readDigits(time, 0, 2, hour) || !readDigits(time, 3, 2, minute) || hour > 23 || minute > 59)
+    {
+        return -1;
+    }
+
+    return hour * 60 + minute;
+}
 
-// Add hours to time string (HH:MM format)
-string addHoursToTime(string timeStr, int hours)
+// "YYYY-MM-DD" + "HH:MM" -> schedule minute (-1 = either one unset or malformed)
+long long toScheduleMinute(string_view date, string_view time)
 {
-    int hour = stoi(timeStr.substr(0, 2));
-    int minute = stoi(timeStr.substr(3, 2));
+    long long midnight = parseScheduleDate(date);
+    int clock = parseClockTime(time);
+    if (midnight < 0 || clock < 0)
+    {
+        return -1;
+    }
 
-    hour = (hour + hours) % 24; // hour
+    return midnight + clock;
+}
 
-    stringstream ss;
-    ss << setfill('0') << setw(2) << hour << ":"
-       << setfill('0') << setw(2) << minute;
+// Schedule minute -> "YYYY-MM-DD" + "HH:MM" ("--" / "--:--" for -1)
+void formatScheduleMinute(long long minute, string &date, string &time)
+{
+    date = formatScheduleDate(minute);
+    time = formatScheduleTime(minute);
+}
 
-    return ss.str();
+// Schedule minute -> "YYYY-MM-DD" ("--" for -1)
+string formatScheduleDate(long long minute)
+{
+    if (minute < 0)
+    {
+        return "--";
+    }
+
+    int year, month, day;
+    civilFromDays(minute / 1440, year, month, day);
+
+    char text[32];
+    snprintf(text, sizeof(text), "%04d-%02d-%02d", year, month, day);
+    return text;
 }
 
-// Calculate time difference in hours
-int calculateTimeDifference(string startTime, string endTime)
+// Schedule minute -> "HH:MM" ("--:--" for -1)
+string formatScheduleTime(long long minute)
 {
-    int startHour = stoi(startTime.substr(0, 2));
-    int startMin = stoi(startTime.substr(3, 2));
+    if (minute < 0)
+    {
+        return "--:--";
+    }
 
-    int endHour = stoi(endTime.substr(0, 2));
-    int endMin = stoi(endTime.substr(3, 2));
+    int clock = static_cast<int>(minute % 1440);
 
-    // Convert to minutes
-    int startTotalMin = startHour * 60 + startMin;
-    int endTotalMin = endHour * 60 + endMin;
+    char text[32];
+    snprintf(text, sizeof(text), "%02d:%02d", clock / 60, clock % 60);
+    return text;
+}
 
-    // Handle next day scenario
-    if (endTotalMin < startTotalMin)
+// Local wall-clock time now, as a schedule minute
+long long currentScheduleMinute()
+{
+    time_t now = time(nullptr);
+    tm *localTime = localtime(&now);
+
+    return daysFromCivil(localTime->tm_year + 1900, localTime->tm_mon + 1, localTime->tm_mday) * 1440 +
+           localTime->tm_hour * 60 + localTime->tm_min;
+}
+
+/* Status */
+
+const char *statusName(AmbulanceStatus status)
+{
+    switch (status)
     {
-        endTotalMin += 24 * 60;
+    case AmbulanceStatus::OnDuty:
+        return "On Duty";
+    case AmbulanceStatus::Standby:
+        return "Standby";
+    default:
+        return "Off Duty";
     }
+}
 
-    // Calculate difference in hours
-    int diffMin = endTotalMin - startTotalMin;
-    return diffMin / 60;
-}
\ No newline at end of file
+// Status text from the data file (anything unknown was shown as off duty)
+AmbulanceStatus parseStatus(string_view text)
+{
+    if (text == "On Duty")
+        return AmbulanceStatus::OnDuty;
+    if (text == "Standby")
+        return AmbulanceStatus::Standby;
+    return AmbulanceStatus::OffDuty;
+}
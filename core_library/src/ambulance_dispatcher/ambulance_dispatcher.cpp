@@ -4,6 +4,8 @@
 #include <windows.h>
 #endif
 #include "core_library/ambulance_dispatcher.hpp"
+#include "core_library/load_progress.hpp"
+#include "core_library/record_parser.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -11,12 +13,13 @@
 #include <iomanip>
 #include <ctime>
 #include <chrono>
-#include <thread>
+#include <charconv>
 using namespace std;
 
 // Constructor
 AmbulanceDispatcher::AmbulanceDispatcher() : nextAmbulanceNumber(1), shiftDurationHours(8)
 {
+    roster.setStandardMinutes(shiftDurationHours * 60);
     loadAmbulancesFromFile("../../data/ambulances.txt");
 }
 
@@ -26,11 +29,74 @@ AmbulanceDispatcher::~AmbulanceDispatcher()
     saveAmbulancesToFile("../../data/ambulances.txt");
 }
 
-// Load ambulances from file
+/*
+ * The file keeps the readable layout
+ *   vehicleID,ambulanceID,driver,status,YYYY-MM-DD,HH:MM,HH:MM
+ * and the fields below turn the last four straight into the integer
+ * schedule. They run in file order, so the date lands in shiftStart
+ * first, the start time adds to it (and parks its clock minute in
+ * shiftMinutes), and the end time turns that into the shift length.
+ * Malformed or "--" values leave the shift unscheduled, as before.
+ */
+struct StatusField
+{
+    static bool apply(Ambulance &ambulance, string_view token, const char *&)
+    {
+        ambulance.status = parseStatus(token);
+        return true;
+    }
+};
+
+struct ScheduleDateField
+{
+    static bool apply(Ambulance &ambulance, string_view token, const char *&)
+    {
+        ambulance.shiftStart = parseScheduleDate(token);
+        return true;
+    }
+};
+
+struct ShiftStartField
+{
+    static bool apply(Ambulance &ambulance, string_view token, const char *&)
+    {
+        int clock = parseClockTime(token);
+        ambulance.shiftStart = ambulance.shiftStart >= 0 && clock >= 0 ? ambulance.shiftStart + clock : -1;
+        ambulance.shiftMinutes = clock;
+        return true;
+    }
+};
+
+struct ShiftEndField
+{
+    static bool apply(Ambulance &ambulance, string_view token, const char *&)
+    {
+        int start = ambulance.shiftMinutes;
+        int end = parseClockTime(token);
+        // Same start and end clock time = a full 24-hour shift
+        if (start >= 0 && end >= 0)
+            ambulance.shiftMinutes = end == start ? 1440 : (end - start + 1440) % 1440;
+        else
+            ambulance.shiftMinutes = 0;
+        return true;
+    }
+};
+
+typedef RecordSchema<Ambulance,
+                     TextField<&Ambulance::vehicleID>,
+                     TextField<&Ambulance::ambulanceID>,
+                     TextField<&Ambulance::driverName>,
+                     StatusField,
+                     ScheduleDateField,
+                     ShiftStartField,
+                     ShiftEndField> AmbulanceSchema;
+
+// Load ambulances from file (one pass; progress is estimated from the
+// bytes read and redrawn a few times per second)
 void AmbulanceDispatcher::loadAmbulancesFromFile(const string &filename)
 {
 
-    ifstream file(filename);
+    ifstream file(filename, ios::binary);
 
     if (!file.is_open())
     {
@@ -38,89 +104,78 @@ void AmbulanceDispatcher::loadAmbulancesFromFile(const string &filename)
         return;
     }
 
+    uint64_t fileBytes = LoadProgress::fileSize(file);
     string line;
     int count = 0;
     int maxAmbNum = 0;
+    uint64_t bytesRead = 0;
 
     // Loading bar
     cout << "\n"
          << C_BOLD << C_CYAN << "🚑 Loading Ambulances from Database..." << C_RESET << endl;
 
-    const string blocks = "▏▎▍▌▋▊▉█";
-    const string spinner[] = {"⠋", "⠙", "⠹", "⠸", "⠼", "⠴", "⠦", "⠧", "⠇", "⠏"};
-    int spinIndex = 0;
-    int total = 0;
-    {
-        string tmp;
-        while (getline(file, tmp))
-            total++;
-        file.clear();
-        file.seekg(0, ios::beg);
-    }
+    const int MAX_REPORTED_LINES = 5;
+    LoadProgress progress(fileBytes);
+    Ambulance ambulance;
+    int lineNumber = 0;
+    int malformed = 0;
 
     while (getline(file, line))
     {
-        stringstream ss(line);
-        string vehicleID, ambulanceID, driver, status, scheduleDate, startTime, endTime;
+        bytesRead += line.size() + 1;
+        lineNumber++;
+        if (line.empty() || line == "\r")
+            continue;
 
-        if (getline(ss, vehicleID, ',') &&
-            getline(ss, ambulanceID, ',') &&
-            getline(ss, driver, ',') &&
-            getline(ss, status, ',') &&
-            getline(ss, scheduleDate, ',') &&
-            getline(ss, startTime, ',') &&
-            getline(ss, endTime, ','))
+        // Fields go straight into the reused record (no stringstream)
+        RecordError error;
+        if (!AmbulanceSchema::parse(line, ambulance, error))
         {
-
-            // Extract vehicle ID for auto-increment
-            if (vehicleID.length() > 3)
+            if (malformed < MAX_REPORTED_LINES)
             {
-                int ambNum = stoi(vehicleID.substr(3));
-                if (ambNum > maxAmbNum)
-                    maxAmbNum = ambNum;
+                cout << "\r" << C_YELLOW << "⚠ Skipped line " << lineNumber << ": field "
+                     << error.field + 1 << " " << error.reason << C_RESET << endl;
             }
-
-            Ambulance ambulance(vehicleID, ambulanceID, driver, status, scheduleDate, startTime, endTime);
-            ambulanceQueue.enqueue(ambulance);
-            count++;
+            malformed++;
+            continue;
         }
 
-        // Progress bar
-        float progress = (float)count / total;
-        int barWidth = 30;
-        int filled = (int)(progress * barWidth);
-
-        string bar;
-        for (int i = 0; i < barWidth; ++i)
+        // Extract vehicle ID for auto-increment
+        if (ambulance.vehicleID.length() > 3)
         {
-            if (i < filled)
-                bar += "█";
-            else
-                bar += " ";
+            int ambNum = 0;
+            from_chars(ambulance.vehicleID.data() + 3, ambulance.vehicleID.data() + ambulance.vehicleID.length(), ambNum);
+            if (ambNum > maxAmbNum)
+                maxAmbNum = ambNum;
         }
 
-        cout << "\r" << C_BOLD << C_GREEN
-             << spinner[spinIndex % 10] << " [" << bar << "] "
-             << setw(3) << int(progress * 100) << "% " << C_RESET;
-        cout.flush();
+        ambulanceQueue.enqueue(std::move(ambulance));
+        count++;
 
-        spinIndex++;
-        std::this_thread::sleep_for(std::chrono::milliseconds(80));
+        progress.update(bytesRead);
     }
 
     // Close file
     file.close();
     nextAmbulanceNumber = maxAmbNum + 1;
 
+    // The loaded shifts become the roster's origin and offsets
+    roster.load(ambulanceQueue);
+
     if (count > 0)
     {
-        cout << "\r" << C_BOLD << C_GREEN
-             << "✅ [██████████████████████████████] 100%" << C_RESET << endl;
+        progress.finish(count, bytesRead > fileBytes ? fileBytes : bytesRead);
         cout << C_GREEN << "\n✓ SUCCESS: " << C_RESET
              << "Loaded " << C_BOLD << count << C_RESET
              << " ambulances from database.\n"
              << endl;
     }
+    if (malformed > 0)
+    {
+        cout << C_YELLOW << "⚠ WARNING: " << C_RESET << malformed
+             << " malformed line(s) in " << filename << " were skipped.\n"
+             << endl;
+    }
 }
 
 // Save ambulances to file
@@ -138,21 +193,25 @@ void AmbulanceDispatcher::saveAmbulancesToFile(const string &filename) const
         return;
     }
 
-    const int MAX_AMB = 50;
-    Ambulance ambulances[MAX_AMB];
-    int count;
-
-    ambulanceQueue.getAllAmbulances(ambulances, count);
+    // Written straight from the queue (no copy of the fleet), each
+    // schedule derived from the roster and formatted only here
+    int count = ambulanceQueue.getSize();
+    string date, startTime, endDate, endTime;
 
     for (int i = 0; i < count; i++)
     {
-        file << ambulances[i].vehicleID << ","
-             << ambulances[i].ambulanceID << ","
-             << ambulances[i].driverName << ","
-             << ambulances[i].status << ","
-             << ambulances[i].scheduleDate << ","
-             << ambulances[i].shiftStartTime << ","
-             << ambulances[i].shiftEndTime << endl;
+        const Ambulance &ambulance = ambulanceQueue.at(i);
+        Shift shift = roster.shiftAt(ambulanceQueue, i);
+        formatScheduleMinute(shift.start, date, startTime);
+        formatScheduleMinute(shift.end, endDate, endTime);
+
+        file << ambulance.vehicleID << ","
+             << ambulance.ambulanceID << ","
+             << ambulance.driverName << ","
+             << statusName(ambulance.status) << ","
+             << date << ","
+             << startTime << ","
+             << endTime << "\n";
     }
 
     file.close();
@@ -172,27 +231,14 @@ string AmbulanceDispatcher::generateNextAmbulanceID()
 // Check if rotation is needed based on duty hours
 bool AmbulanceDispatcher::isRotationNeeded() const
 {
-    Ambulance currentDuty;
-    if (!ambulanceQueue.getFront(currentDuty))
+    if (ambulanceQueue.isEmpty())
     {
         return false;
     }
 
     // Check if current shift has ended
-    string currentDate = getCurrentDateString();
-    string currentTime = getCurrentTimeString();
-    if (currentDate > currentDuty.scheduleDate)
-    {
-        return true;
-    }
-
-    // Same date, check time
-    if (currentDate == currentDuty.scheduleDate)
-    {
-        return (currentTime >= currentDuty.shiftEndTime && currentDuty.shiftEndTime != "--:--" && currentDuty.shiftEndTime > currentDuty.shiftStartTime);
-    }
-
-    return false;
+    Shift currentDuty = roster.shiftAt(ambulanceQueue, 0);
+    return currentDuty.start >= 0 && currentScheduleMinute() >= currentDuty.end;
 }
 
 // Format duration display
@@ -247,72 +293,34 @@ void AmbulanceDispatcher::registerAmbulance()
         }
     } while (driver.empty());
 
-    // Determine initial status
-    string status = "Standby";
-    string shiftStart = "--:--";
-    string shiftEnd = "--:--";
-    string scheduleDate = getCurrentDateString();
-    if (ambulanceQueue.isEmpty())
-    {
-        // First ambulance - assign current time as start
-        status = "On Duty";
-        shiftStart = getCurrentTimeString();
-        shiftEnd = addHoursToTime(shiftStart, shiftDurationHours);
-
-        if (shiftEnd < shiftStart)
-        {
-            addHoursToDateTime(scheduleDate, shiftStart, 0);
-        }
+    // Determine initial status; the roster gives the new ambulance the
+    // shift after the last one in the rotation (the first starts now)
+    bool first = ambulanceQueue.isEmpty();
+    ambulanceQueue.emplace(vehicleID, ambulanceID, driver, first ? AmbulanceStatus::OnDuty : AmbulanceStatus::Standby);
+    roster.append(ambulanceQueue, currentScheduleMinute());
 
+    Shift added = roster.shiftAt(ambulanceQueue, ambulanceQueue.getSize() - 1);
+    if (first)
+    {
         cout << C_GREEN << "\n✓ First ambulance registered!" << C_RESET << endl;
         cout << C_GREEN << "  Status: " << C_BOLD << "On Duty" << C_RESET << endl;
-        cout << C_GREEN << "  Date: " << C_BOLD << scheduleDate << " (" << getDayOfWeek() << ")" << C_RESET << endl;
-        cout << C_GREEN << "  Shift: " << C_BOLD << shiftStart << " - " << shiftEnd
+        cout << C_GREEN << "  Date: " << C_BOLD << formatScheduleDate(added.start) << " (" << getDayOfWeek() << ")" << C_RESET << endl;
+        cout << C_GREEN << "  Shift: " << C_BOLD << formatScheduleTime(added.start) << " - " << formatScheduleTime(added.end)
              << C_RESET << " (" << shiftDurationHours << " hours)" << endl;
     }
     else
     {
-        // Calculate next available shift time based on last ambulance
-        const int MAX_AMB = 50;
-        Ambulance ambulances[MAX_AMB];
-        int count;
-        ambulanceQueue.getAllAmbulances(ambulances, count);
-
-        // Find the latest shift end time
-        if (count > 0)
-        {
-            Ambulance lastAmbulance = ambulances[count - 1];
-            if (lastAmbulance.shiftEndTime != "--:--")
-            {
-                // Base date from previous ambulance
-                scheduleDate = lastAmbulance.scheduleDate;
-                shiftStart = lastAmbulance.shiftEndTime;
-                shiftEnd = addHoursToTime(shiftStart, shiftDurationHours);
-
-                if (shiftStart == "00:00" || (shiftEnd < shiftStart && shiftEnd != "00:00"))
-                {
-                    addHoursToDateTime(scheduleDate, shiftStart, 24); // Move to next day
-                }
-            }
-        }
-
         cout << C_YELLOW << "\n✓ Status: " << C_BOLD << "Standby"
              << C_RESET << " (Scheduled for rotation)" << endl;
-        if (shiftStart != "--:--")
+        if (added.start >= 0)
         {
-            cout << C_YELLOW << "  Scheduled Shift: " << C_BOLD << shiftStart << " - " << shiftEnd
-                 << C_RESET << " (" << shiftDurationHours << " hours)" << endl;
+            cout << C_YELLOW << "  Scheduled Shift: " << C_BOLD << formatScheduleDate(added.start) << " "
+                 << formatScheduleTime(added.start) << " - " << formatScheduleTime(added.end) << C_RESET << " (" << shiftDurationHours << " hours)" << endl;
         }
     }
 
-    // Create ambulance object
-    Ambulance newAmbulance(vehicleID, ambulanceID, driver, status, scheduleDate, shiftStart, shiftEnd);
-
-    // Add to queue
-    ambulanceQueue.enqueue(newAmbulance);
-
     cout << C_GREEN << "\n✓ SUCCESS: " << C_RESET << "Ambulance "
-         << C_BOLD << newAmbulance.ambulanceID << C_RESET
+         << C_BOLD << ambulanceID << C_RESET
          << " registered and added to rotation!" << endl;
 
     cout << "\n"
@@ -329,12 +337,11 @@ void AmbulanceDispatcher::autoScheduleCheck()
 {
     if (isRotationNeeded())
     {
-        Ambulance current;
-        ambulanceQueue.getFront(current);
+        const Ambulance &current = ambulanceQueue.front();
         cout << "\n"
              << C_RED << C_BOLD << "⚠ AUTO-SCHEDULE ALERT!" << C_RESET << endl;
         cout << C_RED << "  Current ambulance (" << current.vehicleID
-             << ") shift ended at " << current.shiftEndTime << C_RESET << endl;
+             << ") shift ended at " << formatScheduleTime(roster.shiftAt(ambulanceQueue, 0).end) << C_RESET << endl;
         cout << C_YELLOW << "  Please rotate shift to maintain continuous coverage!" << C_RESET << endl;
     }
 }
@@ -358,20 +365,18 @@ void AmbulanceDispatcher::rotateAmbulanceShift()
         cout << C_YELLOW << "\n⚠ INFO: " << C_RESET << "Only one ambulance in system." << endl;
         cout << "Extending current shift by " << shiftDurationHours << " hours..." << endl;
 
-        Ambulance current;
-        ambulanceQueue.getFront(current);
-        current.shiftStartTime = current.shiftEndTime;
-        current.shiftEndTime = addHoursToTime(current.shiftStartTime, shiftDurationHours);
-        ambulanceQueue.updateFront(current);
+        // Its next shift starts where this one ends
+        roster.rotated(ambulanceQueue);
 
-        cout << C_GREEN << "\n✓ Shift extended: " << current.shiftStartTime
-             << " - " << current.shiftEndTime << C_RESET << endl;
+        Shift extended = roster.shiftAt(ambulanceQueue, 0);
+        cout << C_GREEN << "\n✓ Shift extended: " << formatScheduleTime(extended.start)
+             << " - " << formatScheduleTime(extended.end) << C_RESET << endl;
         return;
     }
 
     // Display current ambulance info
-    Ambulance currentDuty;
-    ambulanceQueue.getFront(currentDuty);
+    const Ambulance &currentDuty = ambulanceQueue.front();
+    Shift currentShift = roster.shiftAt(ambulanceQueue, 0);
     string currentTime = getCurrentTimeString();
 
     cout << "\n"
@@ -382,11 +387,12 @@ void AmbulanceDispatcher::rotateAmbulanceShift()
     cout << "  Vehicle ID: " << C_GREEN << currentDuty.vehicleID << C_RESET << endl;
     cout << "  Registration: " << currentDuty.ambulanceID << endl;
     cout << "  Driver: " << currentDuty.driverName << endl;
-    cout << "  Shift: " << C_YELLOW << currentDuty.shiftStartTime << " - "
-         << currentDuty.shiftEndTime << C_RESET << " (" << currentDuty.getShiftDurationHours() << " hrs)" << endl;
+    cout << "  Shift: " << C_YELLOW << formatScheduleTime(currentShift.start) << " - "
+         << formatScheduleTime(currentShift.end) << C_RESET << " ("
+         << (currentShift.start >= 0 ? currentDuty.shiftMinutes / 60 : 0) << " hrs)" << endl;
 
     // Check if shift has ended
-    bool shiftEnded = (currentTime >= currentDuty.shiftEndTime && currentDuty.shiftEndTime != "--:--");
+    bool shiftEnded = isRotationNeeded();
 
     if (shiftEnded)
     {
@@ -396,7 +402,7 @@ void AmbulanceDispatcher::rotateAmbulanceShift()
     {
         cout << "\n"
              << C_YELLOW << "⚠ NOTICE: " << C_RESET
-             << "Current shift ends at " << C_YELLOW << currentDuty.shiftEndTime << C_RESET << endl;
+             << "Current shift ends at " << C_YELLOW << formatScheduleTime(currentShift.end) << C_RESET << endl;
         cout << "Current time is " << C_CYAN << currentTime << C_RESET << ". Shift is still active." << endl;
     }
 
@@ -430,52 +436,24 @@ void AmbulanceDispatcher::rotateAmbulanceShift()
     displayUpcomingRotation();
 }
 
-// Normal rotation
+// Normal rotation: the next ambulance takes over at its planned start
+// (O(1): only the roster's origin moves)
 void AmbulanceDispatcher::normalRotate()
 {
-    Ambulance currentDuty;
-    ambulanceQueue.getFront(currentDuty);
-
-    // Get all ambulances to properly update the rotated one
-    const int MAX_AMB = 50;
-    Ambulance ambulances[MAX_AMB];
-    int count;
-    ambulanceQueue.getAllAmbulances(ambulances, count);
-
-    // The second ambulance = 1
-    string nextShiftStart = (count > 1) ? ambulances[1].shiftStartTime : addHoursToTime(currentDuty.shiftEndTime, 0);
-    string nextShiftEnd = (count > 1) ? ambulances[1].shiftEndTime : addHoursToTime(nextShiftStart, shiftDurationHours);
+    int count = ambulanceQueue.getSize();
 
-    // Calculate new schedule for the ambulance moving to rear
-    string rotatedDate = ambulances[count - 1].scheduleDate;
-    string rotatedStartTime = ambulances[count - 1].shiftEndTime;
-    string rotatedEndTime = addHoursToTime(rotatedStartTime, shiftDurationHours);
-
-    if (rotatedStartTime == "00:00" || (rotatedEndTime < rotatedStartTime && rotatedEndTime != "00:00"))
-    {
-        // This shift (midnight or more) = next day
-        string tempDate = rotatedDate;
-        addHoursToDateTime(tempDate, rotatedStartTime, 0);
-        addHoursToDateTime(rotatedDate, rotatedStartTime, 24);
-    }
+    // Shift just completed (reported below)
+    Shift completed = roster.shiftAt(ambulanceQueue, 0);
 
+    // Rotate: the old front is now the rear, in place (statuses are set)
     ambulanceQueue.rotate();
+    roster.rotated(ambulanceQueue);
 
-    // Update new on-duty ambulance with its original schedule
-    Ambulance newDuty;
-    ambulanceQueue.getFront(newDuty);
-    newDuty.status = "On Duty";
-    newDuty.shiftStartTime = nextShiftStart;
-    newDuty.shiftEndTime = nextShiftEnd;
-    ambulanceQueue.updateFront(newDuty);
-
-    // Update rear (the rotated ambulance)
-    Ambulance rotatedAmb = currentDuty;
-    rotatedAmb.status = "Standby";
-    rotatedAmb.scheduleDate = rotatedDate;
-    rotatedAmb.shiftStartTime = rotatedStartTime;
-    rotatedAmb.shiftEndTime = rotatedEndTime;
-    ambulanceQueue.updateRear(rotatedAmb);
+    // Only the two ambulances reported below are looked up
+    const Ambulance &newDuty = ambulanceQueue.front();
+    const Ambulance &rotatedAmb = ambulanceQueue.rear();
+    Shift newShift = roster.shiftAt(ambulanceQueue, 0);
+    Shift rotatedShift = roster.shiftAt(ambulanceQueue, count - 1);
 
     cout << "\n"
          << C_GREEN << "═══════════════════════════════════════════════" << C_RESET << endl;
@@ -484,105 +462,38 @@ void AmbulanceDispatcher::normalRotate()
 
     cout << "\n"
          << C_BOLD << "Shift Changes:" << C_RESET << endl;
-    cout << "  " << currentDuty.vehicleID << " (" << currentDuty.driverName << ")" << endl;
+    cout << "  " << rotatedAmb.vehicleID << " (" << rotatedAmb.driverName << ")" << endl;
     cout << "    Status: " << C_YELLOW << "On Duty → Standby" << C_RESET << endl;
-    cout << "    Completed: " << currentDuty.scheduleDate << " " << currentDuty.shiftStartTime << " - " << currentDuty.shiftEndTime << endl;
-    cout << "    New Schedule: " << C_CYAN << rotatedDate << " " << rotatedStartTime << " - " << rotatedEndTime << C_RESET
-         << " (" << shiftDurationHours << " hrs)" << endl;
+    cout << "    Completed: " << formatScheduleDate(completed.start) << " " << formatScheduleTime(completed.start)
+         << " - " << formatScheduleTime(completed.end) << endl;
+    cout << "    New Schedule: " << C_CYAN << formatScheduleDate(rotatedShift.start) << " "
+         << formatScheduleTime(rotatedShift.start) << " - " << formatScheduleTime(rotatedShift.end) << C_RESET << " (" << shiftDurationHours << " hrs)" << endl;
 
     cout << "\n  " << C_GREEN << newDuty.vehicleID << " (" << newDuty.driverName << ")" << C_RESET << endl;
     cout << "    Status: " << C_GREEN << "Standby → On Duty" << C_RESET << endl;
-    cout << "    Shift: " << C_GREEN << newDuty.scheduleDate << " " << newDuty.shiftStartTime << " - "
-         << newDuty.shiftEndTime << C_RESET << " (" << calculateTimeDifference(newDuty.shiftStartTime, newDuty.shiftEndTime) << " hrs)" << endl;
+    cout << "    Shift: " << C_GREEN << formatScheduleDate(newShift.start) << " " << formatScheduleTime(newShift.start)
+         << " - " << formatScheduleTime(newShift.end) << C_RESET << " (" << newDuty.shiftMinutes / 60 << " hrs)" << endl;
 }
 
-// Dynamic rotation
+// Dynamic rotation: the next ambulance starts now and everyone behind it
+// moves up (O(1) while all shifts have the standard length: every later
+// shift is derived from the new origin)
 void AmbulanceDispatcher::dynamicRotate()
 {
-    Ambulance currentDuty;
-    ambulanceQueue.getFront(currentDuty);
-
-    string currentTime = getCurrentTimeString();
-    string currentDate = getCurrentDateString();
+    int count = ambulanceQueue.getSize();
 
-    const int MAX_AMB = 50;
-    Ambulance ambulances[MAX_AMB];
-    int count;
-    ambulanceQueue.getAllAmbulances(ambulances, count);
+    // Shift just completed (reported below)
+    Shift completed = roster.shiftAt(ambulanceQueue, 0);
 
     // Perform rotation
     ambulanceQueue.rotate();
+    roster.restart(ambulanceQueue, currentScheduleMinute());
 
-    // Update new on-duty ambulance
-    Ambulance newDuty = ambulances[1];
-    newDuty.status = "On Duty";
-    newDuty.scheduleDate = currentDate;
-    newDuty.shiftStartTime = currentTime;
-    newDuty.shiftEndTime = addHoursToTime(currentTime, shiftDurationHours);
-
-    // Update the front ambulance
-    ambulanceQueue.updateFront(newDuty);
-
-    // Update all subsequent ambulances' schedules
-    string nextDate = currentDate;
-    string nextStart = newDuty.shiftEndTime;
-
-    // Check if first shift crosses midnight (yes = increment date)
-    if (nextStart < currentTime)
-    {
-        addHoursToDateTime(nextDate, currentTime, shiftDurationHours);
-        nextStart = newDuty.shiftEndTime; // Keep time
-    }
-
-    // Rotate array
-    Ambulance rotatedAmbulances[MAX_AMB];
-    rotatedAmbulances[0] = newDuty;
-
-    // Copy remaining ambulances and update their schedules
-    for (int i = 2; i < count; i++)
-    {
-        rotatedAmbulances[i - 1] = ambulances[i];
-        rotatedAmbulances[i - 1].scheduleDate = nextDate;
-        rotatedAmbulances[i - 1].shiftStartTime = nextStart;
-        rotatedAmbulances[i - 1].shiftEndTime = addHoursToTime(nextStart, shiftDurationHours);
-
-        // Check cross midnight - increment date
-        if (rotatedAmbulances[i - 1].shiftEndTime < nextStart)
-        {
-            addHoursToDateTime(nextDate, nextStart, shiftDurationHours);
-            rotatedAmbulances[i - 1].scheduleDate = nextDate;
-        }
-
-        nextDate = rotatedAmbulances[i - 1].scheduleDate;
-        nextStart = rotatedAmbulances[i - 1].shiftEndTime;
-    }
-
-    // Add the old on-duty ambulance to the end
-    rotatedAmbulances[count - 1] = ambulances[0];
-    rotatedAmbulances[count - 1].status = "Standby";
-    rotatedAmbulances[count - 1].scheduleDate = nextDate;
-    rotatedAmbulances[count - 1].shiftStartTime = nextStart;
-    rotatedAmbulances[count - 1].shiftEndTime = addHoursToTime(nextStart, shiftDurationHours);
-
-    // Handle day transition for last ambulance
-    if (rotatedAmbulances[count - 1].shiftEndTime < nextStart)
-    {
-        addHoursToDateTime(nextDate, nextStart, shiftDurationHours);
-        rotatedAmbulances[count - 1].scheduleDate = nextDate;
-    }
-
-    // Clear the queue and rebuild with new schedules
-    while (!ambulanceQueue.isEmpty())
-    {
-        Ambulance temp;
-        ambulanceQueue.dequeue(temp);
-    }
-
-    // Re-enqueue with updated schedules
-    for (int i = 0; i < count; i++)
-    {
-        ambulanceQueue.enqueue(rotatedAmbulances[i]);
-    }
+    // Only the two ambulances reported below are looked up
+    const Ambulance &newDuty = ambulanceQueue.front();
+    const Ambulance &rotatedAmb = ambulanceQueue.rear();
+    Shift newShift = roster.shiftAt(ambulanceQueue, 0);
+    Shift rotatedShift = roster.shiftAt(ambulanceQueue, count - 1);
 
     cout << "\n"
          << C_GREEN << "═══════════════════════════════════════════════" << C_RESET << endl;
@@ -591,23 +502,24 @@ void AmbulanceDispatcher::dynamicRotate()
 
     cout << "\n"
          << C_BOLD << "Shift Changes:" << C_RESET << endl;
-    cout << "  " << currentDuty.vehicleID << " (" << currentDuty.driverName << ")" << endl;
+    cout << "  " << rotatedAmb.vehicleID << " (" << rotatedAmb.driverName << ")" << endl;
     cout << "    Status: " << C_YELLOW << "On Duty → Standby" << C_RESET << endl;
-    cout << "    Completed: " << currentDuty.scheduleDate << " " << currentDuty.shiftStartTime << " - " << currentDuty.shiftEndTime << endl;
-    cout << "    New Schedule: " << rotatedAmbulances[count - 1].scheduleDate << " "
-         << rotatedAmbulances[count - 1].shiftStartTime << " - "
-         << rotatedAmbulances[count - 1].shiftEndTime << endl;
+    cout << "    Completed: " << formatScheduleDate(completed.start) << " " << formatScheduleTime(completed.start)
+         << " - " << formatScheduleTime(completed.end) << endl;
+    cout << "    New Schedule: " << formatScheduleDate(rotatedShift.start) << " "
+         << formatScheduleTime(rotatedShift.start) << " - "
+         << formatScheduleTime(rotatedShift.end) << endl;
 
     cout << "\n  " << C_GREEN << newDuty.vehicleID << " (" << newDuty.driverName << ")" << C_RESET << endl;
     cout << "    Status: " << C_GREEN << "Standby → On Duty" << C_RESET << endl;
-    cout << "    New Shift: " << C_GREEN << newDuty.scheduleDate << " " << newDuty.shiftStartTime << " - "
-         << newDuty.shiftEndTime << C_RESET << " (" << shiftDurationHours << " hrs)" << endl;
+    cout << "    New Shift: " << C_GREEN << formatScheduleDate(newShift.start) << " " << formatScheduleTime(newShift.start)
+         << " - " << formatScheduleTime(newShift.end) << C_RESET << " (" << shiftDurationHours << " hrs)" << endl;
 
     cout << C_CYAN << "\n📅 All " << count << " ambulances' schedules updated!" << C_RESET << endl;
 }
 
 // Display upcoming rotation schedule
-void AmbulanceDispatcher::displayUpcomingRotation() const
+void AmbulanceDispatcher::displayUpcomingRotation()
 {
     if (ambulanceQueue.getSize() < 2)
         return;
@@ -617,24 +529,17 @@ void AmbulanceDispatcher::displayUpcomingRotation() const
     cout << C_BOLD << "  📅 NEXT ROTATION SCHEDULE" << C_RESET << endl;
     cout << C_CYAN << "───────────────────────────────────────────────" << C_RESET << endl;
 
-    Ambulance current;
-    ambulanceQueue.getFront(current);
+    Shift current = roster.shiftAt(ambulanceQueue, 0);
+    Shift upcoming = roster.shiftAt(ambulanceQueue, 1);
 
-    cout << "  Next rotation scheduled at: " << C_YELLOW << C_BOLD << current.shiftEndTime << C_RESET << endl;
+    cout << "  Next rotation scheduled at: " << C_YELLOW << C_BOLD << formatScheduleTime(current.end) << C_RESET << endl;
 
     // Get next ambulance
-    const int MAX_AMB = 50;
-    Ambulance ambulances[MAX_AMB];
-    int count;
-    ambulanceQueue.getAllAmbulances(ambulances, count);
-
-    if (count > 1)
-    {
-        cout << "  Next on duty: " << C_GREEN << ambulances[1].vehicleID
-             << C_RESET << " (Driver: " << ambulances[1].driverName << ")" << endl;
-        cout << "  Scheduled: " << ambulances[1].shiftStartTime << " - "
-             << ambulances[1].shiftEndTime << endl;
-    }
+    const Ambulance &next = ambulanceQueue.at(1);
+    cout << "  Next on duty: " << C_GREEN << next.vehicleID
+         << C_RESET << " (Driver: " << next.driverName << ")" << endl;
+    cout << "  Scheduled: " << formatScheduleTime(upcoming.start) << " - "
+         << formatScheduleTime(upcoming.end) << endl;
 
     cout << C_CYAN << "───────────────────────────────────────────────" << C_RESET << endl;
 
@@ -642,7 +547,7 @@ void AmbulanceDispatcher::displayUpcomingRotation() const
 }
 
 /* ==========================  Functionality 3: Display Ambulance Schedule ========================= */
-void AmbulanceDispatcher::displayAmbulanceSchedule() const
+void AmbulanceDispatcher::displayAmbulanceSchedule()
 {
     if (ambulanceQueue.isEmpty())
     {
@@ -676,6 +581,7 @@ void AmbulanceDispatcher::displayAmbulanceSchedule() const
          << setw(10) << "Duration" << endl;
     cout << string(120, '-') << endl;
 
+    roster.materialize(ambulanceQueue, 0, ambulanceQueue.getSize());
     ambulanceQueue.display();
 
     cout << C_CYAN << string(120, '=') << C_RESET << endl;
@@ -696,11 +602,7 @@ void AmbulanceDispatcher::displayDutyStatistics() const
         return;
     }
 
-    const int MAX_AMB = 50;
-    Ambulance ambulances[MAX_AMB];
-    int count;
-
-    ambulanceQueue.getAllAmbulances(ambulances, count);
+    int count = ambulanceQueue.getSize();
 
     cout << "\n"
          << C_CYAN << string(70, '=') << C_RESET << endl;
@@ -713,12 +615,13 @@ void AmbulanceDispatcher::displayDutyStatistics() const
 
     for (int i = 0; i < count; i++)
     {
-        if (ambulances[i].status == "On Duty")
+        const Ambulance &ambulance = ambulanceQueue.at(i);
+        if (ambulance.status == AmbulanceStatus::OnDuty)
             onDutyCount++;
-        else if (ambulances[i].status == "Standby")
+        else if (ambulance.status == AmbulanceStatus::Standby)
             standbyCount++;
 
-        int shiftHours = ambulances[i].getShiftDurationHours();
+        int shiftHours = roster.isScheduled() ? ambulance.shiftMinutes / 60 : 0;
         totalScheduledHours += shiftHours;
     }
 
@@ -737,7 +640,7 @@ void AmbulanceDispatcher::displayDutyStatistics() const
 
     cout << "\n"
          << C_BOLD << "Rotation System:" << C_RESET << endl;
-    cout << "  Type: " << C_CYAN << "Circular Queue (Linked List)" << C_RESET << endl;
+    cout << "  Type: " << C_CYAN << "Circular Queue (Ring Buffer)" << C_RESET << endl;
     cout << "  Principle: Equal duty time distribution" << endl;
     cout << "  Coverage: Continuous 24/7 operation" << endl;
     cout << "  Rotation Modes: Normal (scheduled) & Dynamic (real-time)" << endl;
@@ -752,6 +655,7 @@ void AmbulanceDispatcher::setShiftDuration(int hours)
     {
         int oldDuration = shiftDurationHours;
         shiftDurationHours = hours;
+        roster.setStandardMinutes(hours * 60);
 
         cout << C_GREEN << "\n✓ Shift duration updated from " << oldDuration
              << " to " << hours << " hours." << C_RESET << endl;
@@ -764,48 +668,11 @@ void AmbulanceDispatcher::setShiftDuration(int hours)
         {
             if (!ambulanceQueue.isEmpty())
             {
-                const int MAX_AMB = 50;
-                Ambulance ambulances[MAX_AMB];
-                int count;
-                ambulanceQueue.getAllAmbulances(ambulances, count);
+                int count = ambulanceQueue.getSize();
 
                 // Keep 1st ambulance start time + recalculate all ambulance
-                string currentDate = ambulances[0].scheduleDate;
-                string currentStart = ambulances[0].shiftStartTime;
-
-                for (int i = 0; i < count; i++)
-                {
-                    ambulances[i].scheduleDate = currentDate;
-                    ambulances[i].shiftStartTime = currentStart;
-                    ambulances[i].shiftEndTime = addHoursToTime(currentStart, hours);
-
-                    // Handle day transition
-                    bool crossesMidnight = (ambulances[i].shiftEndTime < currentStart) || (ambulances[i].shiftEndTime == "00:00");
-
-                    if (crossesMidnight)
-                    {
-                        // Advance current ambulance’s schedule date
-                        string tempDate = currentDate;
-                        string tempTime = currentStart;
-                        addHoursToDateTime(tempDate, tempTime, hours);
-                        currentDate = tempDate;
-                    }
-
-                    // Update start time for next iteration
-                    currentStart = ambulances[i].shiftEndTime;
-                }
-
-                // Rebuild queue
-                while (!ambulanceQueue.isEmpty())
-                {
-                    Ambulance temp;
-                    ambulanceQueue.dequeue(temp);
-                }
-
-                for (int i = 0; i < count; i++)
-                {
-                    ambulanceQueue.enqueue(ambulances[i]);
-                }
+                // (back-to-back shifts of the new length from there)
+                roster.rebuild(ambulanceQueue, roster.shiftAt(ambulanceQueue, 0).start);
 
                 cout << C_GREEN << "\n✓ All " << count << " ambulance schedules updated with new duration!" << C_RESET << endl;
                 cout << C_CYAN << "New schedule:" << C_RESET << endl;
@@ -823,6 +690,165 @@ void AmbulanceDispatcher::setShiftDuration(int hours)
     }
 }
 
+/* ========================== Functionality 4: Rotation Planner ========================== */
+
+// Read "YYYY-MM-DD HH:MM" (-1 = malformed)
+static long long readScheduleMinute(const char *prompt)
+{
+    string date, time;
+    cout << prompt << C_YELLOW << " (YYYY-MM-DD HH:MM): " << C_RESET;
+    cin >> date >> time;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    return toScheduleMinute(date, time);
+}
+
+// Ask which question to answer; every answer comes from the roster's
+// closed form, so dates weeks ahead cost no more than today
+void AmbulanceDispatcher::planRotation() const
+{
+    cout << "\n"
+         << C_CYAN << string(60, '=') << C_RESET << endl;
+    cout << C_BOLD << C_CYAN << "           ROTATION PLANNER" << C_RESET << endl;
+    cout << C_CYAN << string(60, '=') << C_RESET << endl;
+
+    if (ambulanceQueue.isEmpty() || !roster.isScheduled())
+    {
+        cout << C_YELLOW << "\n⚠ INFO: " << C_RESET << "No rotation scheduled yet." << endl;
+        return;
+    }
+
+    cout << "(Assumes every later rotation is a normal one)" << endl;
+    cout << "  " << C_CYAN << "1." << C_RESET << " Who is on duty at a given time" << endl;
+    cout << "  " << C_CYAN << "2." << C_RESET << " All shifts in a time window" << endl;
+    cout << "  " << C_CYAN << "3." << C_RESET << " Next shift of an ambulance" << endl;
+    cout << "\nEnter choice (1-3): ";
+
+    int choice;
+    if (!(cin >> choice))
+    {
+        cin.clear();
+        choice = 0;
+    }
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+    switch (choice)
+    {
+    case 1:
+    {
+        long long minute = readScheduleMinute("At");
+        if (minute < 0)
+            break;
+        displayDutyAt(minute);
+        return;
+    }
+    case 2:
+    {
+        long long from = readScheduleMinute("From");
+        long long to = from < 0 ? -1 : readScheduleMinute("To  ");
+        if (to < 0)
+            break;
+        displayShiftsBetween(from, to);
+        return;
+    }
+    case 3:
+    {
+        string vehicleID;
+        cout << "Vehicle ID " << C_YELLOW << "(e.g., AMB001): " << C_RESET;
+        getline(cin, vehicleID);
+        long long minute = readScheduleMinute("From");
+        if (minute < 0)
+            break;
+        displayNextShiftOf(vehicleID, minute);
+        return;
+    }
+    default:
+        cout << C_RED << "\n✗ Invalid choice." << C_RESET << endl;
+        return;
+    }
+
+    cout << C_RED << "\n✗ Invalid date or time." << C_RESET << endl;
+}
+
+// Who is on duty at `minute`
+void AmbulanceDispatcher::displayDutyAt(long long minute) const
+{
+    Shift shift;
+    int position = roster.coveringPosition(ambulanceQueue, minute, shift);
+    if (position < 0)
+    {
+        cout << C_YELLOW << "\n⚠ No shift planned at " << formatScheduleDate(minute) << " "
+             << formatScheduleTime(minute) << " (before the current shift)." << C_RESET << endl;
+        return;
+    }
+
+    const Ambulance &ambulance = ambulanceQueue.at(position);
+    cout << "\n"
+         << C_BOLD << "On duty at " << formatScheduleDate(minute) << " " << formatScheduleTime(minute) << ":" << C_RESET << endl;
+    cout << "  " << C_GREEN << ambulance.vehicleID << C_RESET << " (" << ambulance.ambulanceID
+         << ", Driver: " << ambulance.driverName << ")" << endl;
+    cout << "  Shift: " << formatScheduleDate(shift.start) << " " << formatScheduleTime(shift.start)
+         << " - " << formatScheduleDate(shift.end) << " " << formatScheduleTime(shift.end) << endl;
+}
+
+// Every shift overlapping [from, to) (the first ones listed, all counted)
+void AmbulanceDispatcher::displayShiftsBetween(long long from, long long to) const
+{
+    const int MAX_LISTED = 100;
+
+    cout << "\n"
+         << left
+         << setw(12) << "Vehicle ID"
+         << setw(20) << "Driver Name"
+         << setw(18) << "Start"
+         << setw(18) << "End" << endl;
+    cout << string(68, '-') << endl;
+
+    int listed = 0;
+    int count = roster.forEachShift(ambulanceQueue, from, to,
+                                    [&](const Ambulance &ambulance, const Shift &shift)
+                                    {
+                                        if (listed == MAX_LISTED)
+                                            return;
+                                        listed++;
+                                        cout << left
+                                             << setw(12) << ambulance.vehicleID
+                                             << setw(20) << ambulance.driverName
+                                             << setw(18) << formatScheduleDate(shift.start) + " " + formatScheduleTime(shift.start)
+                                             << setw(18) << formatScheduleDate(shift.end) + " " + formatScheduleTime(shift.end) << endl;
+                                    });
+
+    if (count > MAX_LISTED)
+    {
+        cout << "  ... " << count - MAX_LISTED << " more" << endl;
+    }
+    cout << C_CYAN << count << " shift(s) in the window." << C_RESET << endl;
+}
+
+// Next shift of one ambulance from `minute` on (O(n) to find it by ID,
+// O(1) for the shift itself)
+void AmbulanceDispatcher::displayNextShiftOf(const string &vehicleID, long long minute) const
+{
+    int count = ambulanceQueue.getSize();
+    int position = -1;
+    for (int i = 0; i < count && position < 0; i++)
+    {
+        if (ambulanceQueue.at(i).vehicleID == vehicleID)
+            position = i;
+    }
+
+    if (position < 0)
+    {
+        cout << C_RED << "\n✗ No ambulance " << vehicleID << " in the rotation." << C_RESET << endl;
+        return;
+    }
+
+    Shift shift = roster.nextShiftOf(ambulanceQueue, position, minute);
+    cout << "\n"
+         << C_BOLD << "Next shift of " << vehicleID << ":" << C_RESET << endl;
+    cout << "  " << C_GREEN << formatScheduleDate(shift.start) << " " << formatScheduleTime(shift.start)
+         << " - " << formatScheduleDate(shift.end) << " " << formatScheduleTime(shift.end) << C_RESET << endl;
+}
+
 // Display menu for ambulance dispatcher
 void AmbulanceDispatcher::displayMenu()
 {
@@ -835,7 +861,8 @@ void AmbulanceDispatcher::displayMenu()
     cout << "  " << C_CYAN << "3." << C_RESET << " Display Ambulance Schedule" << endl;
     cout << "  " << C_CYAN << "4." << C_RESET << " View Duty Statistics" << endl;
     cout << "  " << C_CYAN << "5." << C_RESET << " Set Shift Duration (Current: " << shiftDurationHours << " hrs)" << endl;
-    cout << "  " << C_RED << "6." << C_RESET << " Exit & Save" << endl;
+    cout << "  " << C_CYAN << "6." << C_RESET << " Rotation Planner (Who Is On Duty When)" << endl;
+    cout << "  " << C_RED << "7." << C_RESET << " Exit & Save" << endl;
     cout << C_BOLD << C_BLUE << string(70, '=') << C_RESET << endl;
     cout << "Enter your choice: ";
 }
@@ -854,7 +881,7 @@ void AmbulanceDispatcher::run()
         {
             cin.clear();
             cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            cout << C_RED << "\n✗ Invalid input! Please enter a number (1-6)." << C_RESET << endl;
+            cout << C_RED << "\n✗ Invalid input! Please enter a number (1-7)." << C_RESET << endl;
             continue;
         }
 
@@ -889,6 +916,10 @@ void AmbulanceDispatcher::run()
         }
 
         case 6:
+            planRotation();
+            break;
+
+        case 7:
             cout << "\n"
                  << C_YELLOW << "Saving scheduling data..." << C_RESET << endl;
             cout << C_GREEN << "\n✓ Data saved successfully to ambulances.txt" << C_RESET << endl;
@@ -897,7 +928,7 @@ void AmbulanceDispatcher::run()
             break;
 
         default:
-            cout << C_RED << "\n✗ Invalid choice! Please select 1-6." << C_RESET << endl;
+            cout << C_RED << "\n✗ Invalid choice! Please select 1-7." << C_RESET << endl;
         }
 
         if (running)
@@ -1,6 +1,7 @@
 #include "core_library/circular_queue.hpp"
 #include <iostream>
 #include <iomanip>
+#include <utility>
 using namespace std;
 
 // ANSI color codes
@@ -12,34 +13,50 @@ using namespace std;
 #define BOLD "\033[1m"
 
 // Constructor
-CircularQueue::CircularQueue() : rear(nullptr), size(0) {}
+CircularQueue::CircularQueue() : slots(nullptr), order(nullptr), capacity(0), head(0), size(0) {}
 
 // Destructor
 CircularQueue::~CircularQueue()
 {
-    if (isEmpty())
-        return;
+    delete[] slots;
+    delete[] order;
+    slots = nullptr;
+    order = nullptr;
+    capacity = 0;
+    head = 0;
+    size = 0;
+}
 
-    Node *front = rear->next;
-    Node *current = front;
+// Double the storage, moving the ambulances over in queue order
+// (O(n), amortised O(1) per enqueue)
+void CircularQueue::grow()
+{
+    int newCapacity = capacity == 0 ? INITIAL_CAPACITY : capacity * 2;
+    Ambulance *newSlots = new Ambulance[newCapacity];
+    int *newOrder = new int[newCapacity];
 
-    // Traverse and delete all nodes
-    do
+    for (int i = 0; i < size; i++)
+    {
+        newSlots[i] = std::move(slots[slotOf(i)]);
+    }
+    for (int i = 0; i < newCapacity; i++)
     {
-        Node *temp = current;
-        current = current->next;
-        delete temp;
-    } while (current != front);
+        newOrder[i] = i;
+    }
 
-    rear = nullptr;
-    size = 0;
+    delete[] slots;
+    delete[] order;
+    slots = newSlots;
+    order = newOrder;
+    capacity = newCapacity;
+    head = 0;
 }
 
 /* Helper */
 // Check queue empty
 bool CircularQueue::isEmpty() const
 {
-    return rear == nullptr;
+    return size == 0;
 }
 
 // Current size
@@ -49,24 +66,28 @@ int CircularQueue::getSize() const
 }
 
 /* Operations */
-// Enqueue: Add an ambulance to the rear of the queue
-void CircularQueue::enqueue(const Ambulance &ambulance)
+// Append an empty slot after the rear and return it
+Ambulance &CircularQueue::pushSlot()
 {
-    Node *newNode = new Node(ambulance);
-
-    if (isEmpty())
-    {
-        rear = newNode;
-        rear->next = rear;
-    }
-    else
+    if (size == capacity)
     {
-        newNode->next = rear->next;
-        rear->next = newNode;
-        rear = newNode;
+        grow();
     }
 
     size++;
+    return slots[slotOf(size - 1)];
+}
+
+// Enqueue: Add an ambulance to the rear of the queue
+void CircularQueue::enqueue(const Ambulance &ambulance)
+{
+    pushSlot() = ambulance;
+}
+
+// Enqueue by move: the ambulance's strings are handed over, not copied
+void CircularQueue::enqueue(Ambulance &&ambulance)
+{
+    pushSlot() = std::move(ambulance);
 }
 
 // Dequeue: Remove the front ambulance from the queue
@@ -78,23 +99,11 @@ bool CircularQueue::dequeue(Ambulance &ambulance)
         return false;
     }
 
-    Node *front = rear->next;
-    ambulance = front->data;
-
-    // Only one node
-    if (rear == front)
-    {
-        delete front;
-        rear = nullptr;
-    }
-    else
-    {
-        // More than one node
-        rear->next = front->next;
-        delete front;
-    }
-
+    // The front slot becomes the last free one
+    ambulance = std::move(slots[order[head]]);
+    head = (head + 1) & (capacity - 1);
     size--;
+
     return true;
 }
 
@@ -111,16 +120,25 @@ bool CircularQueue::rotate()
         return true;
     }
 
+    int mask = capacity - 1;
+
     // Update curr ambulance status
-    Node *front = rear->next;
-    front->data.status = "Standby";
+    slots[order[head]].status = AmbulanceStatus::Standby;
 
-    // Rotate
-    rear = rear->next;
+    // Rotate: a full ring already has the old front right after the
+    // rear; otherwise its slot number trades places with the free one
+    // there (the ambulance itself stays put)
+    if (size < capacity)
+    {
+        int after = (head + size) & mask;
+        int freeSlot = order[after];
+        order[after] = order[head];
+        order[head] = freeSlot;
+    }
+    head = (head + 1) & mask;
 
     // Update front = on duty
-    Node *newFront = rear->next;
-    newFront->data.status = "On Duty";
+    slots[order[head]].status = AmbulanceStatus::OnDuty;
 
     return true;
 }
@@ -134,13 +152,10 @@ void CircularQueue::display() const
         return;
     }
 
-    Node *front = rear->next;
-    Node *current = front;
-    int position = 1;
-
-    // Traverse the circular queue and display
-    do
+    // Walk the ring front to rear
+    for (int i = 0; i < size; i++)
     {
+        int position = i + 1;
         if (position == 1)
         {
             cout << GREEN << "► [ON DUTY] " << RESET;
@@ -149,10 +164,8 @@ void CircularQueue::display() const
         {
             cout << "  [" << position << "]      ";
         }
-        current->data.display();
-        current = current->next;
-        position++;
-    } while (current != front);
+        slots[slotOf(i)].display();
+    }
 }
 
 // Get front ambulance without removing it
@@ -163,7 +176,7 @@ bool CircularQueue::getFront(Ambulance &ambulance) const
         return false;
     }
 
-    ambulance = rear->next->data;
+    ambulance = slots[slotOf(0)];
     return true;
 }
 
@@ -175,7 +188,7 @@ bool CircularQueue::updateFront(const Ambulance &ambulance)
         return false;
     }
 
-    rear->next->data = ambulance;
+    slots[slotOf(0)] = ambulance;
     return true;
 }
 
@@ -187,26 +200,58 @@ bool CircularQueue::updateRear(const Ambulance &ambulance)
         return false;
     }
     
-    rear->data = ambulance;
+    slots[slotOf(size - 1)] = ambulance;
     return true;
 }
 
 // Get all ambulances for file saving
 void CircularQueue::getAllAmbulances(Ambulance ambulances[], int &count) const
 {
-    if (isEmpty())
+    count = 0;
+
+    for (int i = 0; i < size; i++)
     {
-        count = 0;
-        return;
+        ambulances[count++] = slots[slotOf(i)];
     }
+}
 
-    Node *front = rear->next;
-    Node *current = front;
-    count = 0;
+/* In-place access */
+Ambulance &CircularQueue::front()
+{
+    return at(0);
+}
 
-    do
+const Ambulance &CircularQueue::front() const
+{
+    return at(0);
+}
+
+Ambulance &CircularQueue::rear()
+{
+    return at(size - 1);
+}
+
+const Ambulance &CircularQueue::rear() const
+{
+    return at(size - 1);
+}
+
+Ambulance &CircularQueue::at(int index)
+{
+    if (index < 0 || index >= size)
     {
-        ambulances[count++] = current->data;
-        current = current->next;
-    } while (current != front);
-}
\ No newline at end of file
+        throw out_of_range("CircularQueue: no ambulance at that position.");
+    }
+
+    return slots[slotOf(index)];
+}
+
+const Ambulance &CircularQueue::at(int index) const
+{
+    if (index < 0 || index >= size)
+    {
+        throw out_of_range("CircularQueue: no ambulance at that position.");
+    }
+
+    return slots[slotOf(index)];
+}
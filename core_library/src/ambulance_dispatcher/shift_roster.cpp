@@ -0,0 +1,324 @@
+#include "core_library/shift_roster.hpp"
+using namespace std;
+
+// Constructor
+ShiftRoster::ShiftRoster() : frontStart(-1), cycleMinutes(0), standardMinutes(8 * 60), uniform(true) {}
+
+/* Helper */
+// Offset of `position` counted from the front's shift (0..cycle-1)
+long long ShiftRoster::relativeOffset(const CircularQueue &queue, int position) const
+{
+    long long offset = queue.at(position).shiftOffset - queue.front().shiftOffset;
+    if (offset < 0)
+    {
+        offset += cycleMinutes;
+    }
+    return offset;
+}
+
+// Make the front the first shift of the cycle (offsets of the first
+// `count` positions; later ones are not placed yet)
+void ShiftRoster::rebase(CircularQueue &queue, int count)
+{
+    int frontOffset = queue.front().shiftOffset;
+
+    for (int i = 0; i < count; i++)
+    {
+        Ambulance &ambulance = queue.at(i);
+        long long offset = ambulance.shiftOffset - frontOffset;
+        if (offset < 0)
+        {
+            offset += cycleMinutes;
+        }
+        ambulance.shiftOffset = static_cast<int>(offset);
+    }
+}
+
+bool ShiftRoster::isScheduled() const
+{
+    return frontStart >= 0;
+}
+
+int ShiftRoster::getStandardMinutes() const
+{
+    return standardMinutes;
+}
+
+void ShiftRoster::setStandardMinutes(int minutes)
+{
+    if (minutes != standardMinutes)
+    {
+        uniform = false;
+    }
+    standardMinutes = minutes;
+}
+
+/* Schedule */
+// Shift of the ambulance at `position`
+Shift ShiftRoster::shiftAt(const CircularQueue &queue, int position) const
+{
+    Shift shift;
+    if (!isScheduled())
+    {
+        shift.start = -1;
+        shift.end = -1;
+        return shift;
+    }
+
+    shift.start = frontStart + relativeOffset(queue, position);
+    shift.end = shift.start + queue.at(position).shiftMinutes;
+    return shift;
+}
+
+// Copy the derived shift starts into the ambulances
+void ShiftRoster::materialize(CircularQueue &queue, int first, int count) const
+{
+    for (int i = first; i < first + count && i < queue.getSize(); i++)
+    {
+        queue.at(i).shiftStart = shiftAt(queue, i).start;
+    }
+}
+
+// Place the newly enqueued rear at the end of the cycle
+void ShiftRoster::append(CircularQueue &queue, long long now)
+{
+    Ambulance &added = queue.rear();
+    added.shiftMinutes = standardMinutes;
+
+    // First ambulance: on duty from now
+    if (queue.getSize() == 1)
+    {
+        frontStart = now;
+        added.shiftOffset = 0;
+        cycleMinutes = standardMinutes;
+        uniform = true;
+        return;
+    }
+
+    if (!isScheduled())
+    {
+        return;
+    }
+
+    // The end of the cycle has to be right before the front
+    if (queue.front().shiftOffset != 0)
+    {
+        rebase(queue, queue.getSize() - 1);
+    }
+
+    added.shiftOffset = static_cast<int>(cycleMinutes);
+    cycleMinutes += standardMinutes;
+}
+
+// Advance the origin to the new front's planned start
+void ShiftRoster::rotated(CircularQueue &queue)
+{
+    if (queue.isEmpty() || !isScheduled())
+    {
+        return;
+    }
+
+    // The old front is the rear now (or still the front, when alone)
+    const Ambulance &previous = queue.rear();
+    long long step = queue.front().shiftOffset - previous.shiftOffset;
+    if (step <= 0)
+    {
+        step += cycleMinutes;
+    }
+    frontStart += step;
+
+    // Its next shift takes the current standard length; it is last in
+    // the cycle once the offsets start at the new front
+    if (previous.shiftMinutes != standardMinutes)
+    {
+        rebase(queue, queue.getSize());
+
+        Ambulance &rear = queue.rear();
+        rear.shiftMinutes = standardMinutes;
+        cycleMinutes = rear.shiftOffset + standardMinutes;
+    }
+}
+
+// New front starts at `minute`; the others follow it back to back
+void ShiftRoster::restart(CircularQueue &queue, long long minute)
+{
+    if (queue.isEmpty())
+    {
+        return;
+    }
+
+    if (!uniform)
+    {
+        rebuild(queue, minute);
+        return;
+    }
+
+    frontStart = minute;
+}
+
+// Standard back-to-back shifts from the front
+void ShiftRoster::rebuild(CircularQueue &queue, long long start)
+{
+    int count = queue.getSize();
+
+    for (int i = 0; i < count; i++)
+    {
+        Ambulance &ambulance = queue.at(i);
+        ambulance.shiftOffset = i * standardMinutes;
+        ambulance.shiftMinutes = standardMinutes;
+    }
+
+    frontStart = count > 0 ? start : -1;
+    cycleMinutes = static_cast<long long>(count) * standardMinutes;
+    uniform = true;
+}
+
+// Rebuild the cycle from the loaded schedule: the front's start, then
+// every ambulance's shift length in queue order
+void ShiftRoster::load(CircularQueue &queue)
+{
+    int count = queue.getSize();
+    if (count == 0)
+    {
+        frontStart = -1;
+        cycleMinutes = 0;
+        uniform = true;
+        return;
+    }
+
+    frontStart = queue.front().shiftStart;
+
+    long long offset = 0;
+    uniform = true;
+    for (int i = 0; i < count; i++)
+    {
+        Ambulance &ambulance = queue.at(i);
+
+        // An unset or empty shift gets the standard length
+        if (ambulance.shiftMinutes <= 0)
+        {
+            ambulance.shiftMinutes = standardMinutes;
+        }
+
+        ambulance.shiftOffset = static_cast<int>(offset);
+        offset += ambulance.shiftMinutes;
+        if (ambulance.shiftMinutes != standardMinutes)
+        {
+            uniform = false;
+        }
+    }
+
+    cycleMinutes = offset;
+}
+
+/* Planning */
+// Ambulance on duty at `minute` (see the two phases in the header)
+int ShiftRoster::coveringPosition(const CircularQueue &queue, long long minute, Shift &shift) const
+{
+    int count = queue.getSize();
+    if (!isScheduled() || count == 0 || minute < frontStart)
+    {
+        return -1;
+    }
+
+    long long planStart = frontStart + cycleMinutes;
+
+    // Turn 0: everyone's next shift, at its offset in the cycle
+    if (minute < planStart)
+    {
+        long long into = minute - frontStart;
+        int position;
+        if (uniform)
+        {
+            position = static_cast<int>(into / standardMinutes);
+        }
+        else
+        {
+            // Offsets from the front grow along the queue: last one <= into
+            int low = 0;
+            int high = count - 1;
+            while (low < high)
+            {
+                int middle = low + (high - low + 1) / 2;
+                if (relativeOffset(queue, middle) <= into)
+                {
+                    low = middle;
+                }
+                else
+                {
+                    high = middle - 1;
+                }
+            }
+            position = low;
+        }
+
+        shift = shiftAt(queue, position);
+        return position;
+    }
+
+    // Later turns: standard shifts in queue order
+    long long period = static_cast<long long>(count) * standardMinutes;
+    long long into = (minute - planStart) % period;
+    int position = static_cast<int>(into / standardMinutes);
+
+    shift.start = minute - into + static_cast<long long>(position) * standardMinutes;
+    shift.end = shift.start + standardMinutes;
+    return position;
+}
+
+Shift ShiftRoster::nextShiftOf(const CircularQueue &queue, int position, long long minute) const
+{
+    // Its shift in turn 0
+    Shift shift = shiftAt(queue, position);
+    if (shift.start < 0 || shift.end > minute)
+    {
+        return shift;
+    }
+
+    // First later turn whose shift ends after `minute`
+    long long period = static_cast<long long>(queue.getSize()) * standardMinutes;
+    long long first = frontStart + cycleMinutes + static_cast<long long>(position) * standardMinutes;
+    long long turns = 0;
+    if (first + standardMinutes <= minute)
+    {
+        turns = (minute - first - standardMinutes) / period + 1;
+    }
+
+    shift.start = first + turns * period;
+    shift.end = shift.start + standardMinutes;
+    return shift;
+}
+
+// Shift running at `minute`, or the current one when `minute` is before it
+int ShiftRoster::firstShiftFrom(const CircularQueue &queue, long long minute, Shift &shift) const
+{
+    if (!isScheduled() || queue.isEmpty())
+    {
+        return -1;
+    }
+
+    if (minute < frontStart)
+    {
+        shift = shiftAt(queue, 0);
+        return 0;
+    }
+
+    return coveringPosition(queue, minute, shift);
+}
+
+// Shift after `shift` (held by `position`) in time order
+int ShiftRoster::nextPlanned(const CircularQueue &queue, int position, Shift &shift) const
+{
+    int next = position + 1 == queue.getSize() ? 0 : position + 1;
+
+    // Still in turn 0: that ambulance's own offset and length
+    if (shift.end < frontStart + cycleMinutes)
+    {
+        shift = shiftAt(queue, next);
+        return next;
+    }
+
+    shift.start = shift.end;
+    shift.end = shift.start + standardMinutes;
+    return next;
+}
@@ -0,0 +1,251 @@
+#include "core_library/emergency_department/case_journal.hpp"
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/* ==================== Platform file calls ==================== */
+
+static int openForAppend(const std::string &filename)
+{
+#ifdef _WIN32
+    return _open(filename.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    return ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+#endif
+}
+
+static long writeSome(int fd, const char *data, size_t length)
+{
+#ifdef _WIN32
+    return _write(fd, data, static_cast<unsigned int>(length));
+#else
+    return static_cast<long>(::write(fd, data, length));
+#endif
+}
+
+static bool syncDescriptor(int fd)
+{
+#ifdef _WIN32
+    return _commit(fd) == 0;
+#else
+    return ::fsync(fd) == 0;
+#endif
+}
+
+static bool truncateDescriptor(int fd, long length)
+{
+#ifdef _WIN32
+    return _chsize(fd, length) == 0;
+#else
+    return ::ftruncate(fd, static_cast<off_t>(length)) == 0;
+#endif
+}
+
+static void closeDescriptor(int fd)
+{
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+/* ==================== Journal ==================== */
+
+// Constructor
+CaseJournal::CaseJournal() : fd(-1), pendingCount(0), recordCount(0) {}
+
+// Destructor
+CaseJournal::~CaseJournal()
+{
+    close();
+}
+
+// Open the journal for appending. Records already in it are counted so
+// the owner knows when to compact, and a torn last line is cut off so
+// new records do not get glued to it.
+bool CaseJournal::open(const std::string &filename)
+{
+    close();
+    
+    path = filename;
+    recordCount = 0;
+    long completeBytes = 0;
+    long fileBytes = 0;
+    {
+        std::ifstream file(filename, std::ios::binary);
+        std::string line;
+        Record record;
+        while (std::getline(file, line))
+        {
+            fileBytes += static_cast<long>(line.size());
+            if (file.eof())
+                break;
+            
+            fileBytes++;
+            completeBytes = fileBytes;
+            if (parseRecord(line, record))
+                recordCount++;
+        }
+    }
+    
+    fd = openForAppend(filename);
+    if (fd < 0)
+        return false;
+    
+    if (fileBytes > completeBytes)
+        truncateDescriptor(fd, completeBytes);
+    return true;
+}
+
+// Commit what is pending and close the file
+void CaseJournal::close()
+{
+    if (fd < 0)
+        return;
+    
+    commit();
+    closeDescriptor(fd);
+    fd = -1;
+}
+
+// Add one line to the current group
+void CaseJournal::append(const std::string &line)
+{
+    pending += line;
+    pending += '\n';
+    pendingCount++;
+    
+    if (pendingCount >= GROUP_LIMIT)
+        commit();
+}
+
+void CaseJournal::logCase(const EmergencyCase &emergencyCase)
+{
+    append("L," + emergencyCase.toString());
+}
+
+void CaseJournal::logTreated(const std::string &caseID)
+{
+    append("T," + caseID);
+}
+
+void CaseJournal::logRetriage(const std::string &caseID, TriageLevel newLevel)
+{
+    append("R," + caseID + "," + std::to_string(static_cast<int>(newLevel)));
+}
+
+void CaseJournal::logCancelled(const std::string &caseID)
+{
+    append("C," + caseID);
+}
+
+/*
+ * GROUP COMMIT
+ * Every pending record goes out in one write() (repeated only if the
+ * kernel takes part of it) followed by one fsync(). On failure the
+ * records stay pending and the next commit tries again.
+ */
+bool CaseJournal::commit()
+{
+    if (pendingCount == 0)
+        return true;
+    if (fd < 0)
+        return false;
+    
+    size_t written = 0;
+    while (written < pending.size())
+    {
+        long result = writeSome(fd, pending.data() + written, pending.size() - written);
+        if (result <= 0)
+            return false;
+        written += static_cast<size_t>(result);
+    }
+    if (!syncDescriptor(fd))
+        return false;
+    
+    recordCount += pendingCount;
+    pending.clear();
+    pendingCount = 0;
+    return true;
+}
+
+// Drop every committed record (the snapshot now holds them)
+bool CaseJournal::truncate()
+{
+    if (fd < 0)
+        return false;
+    
+    commit();
+    if (!truncateDescriptor(fd, 0) || !syncDescriptor(fd))
+        return false;
+    
+    recordCount = 0;
+    return true;
+}
+
+/* ==================== Recovery ==================== */
+
+// Body of an 'R' record: caseID,new triage level
+typedef RecordSchema<CaseJournal::Record,
+                     TextField<&CaseJournal::Record::caseID>,
+                     IntField<&CaseJournal::Record::triageLevel, RESUSCITATION, NON_URGENT>> RetriageSchema;
+
+// Parse one journal line
+bool CaseJournal::parseRecord(const std::string &line, Record &record)
+{
+    if (line.size() < 3 || line[1] != ',')
+        return false;
+    
+    record.type = line[0];
+    std::string_view body = std::string_view(line).substr(2);
+    RecordError error;
+    
+    switch (record.type)
+    {
+        case 'L':
+            // caseID,name,type,triage,symptoms,time,date,waiting
+            if (!EmergencyCase::parse(body, record.emergencyCase, error))
+                return false;
+            record.caseID = record.emergencyCase.caseID;
+            return true;
+        
+        case 'R':
+            return RetriageSchema::parse(body, record, error);
+        
+        case 'T':
+        case 'C':
+            record.caseID.assign(body.data(), body.size());
+            return true;
+        
+        default:
+            return false;
+    }
+}
+
+// Flush a file's data to disk
+bool CaseJournal::syncFile(const std::string &filename)
+{
+    int fileFd = openForAppend(filename);
+    if (fileFd < 0)
+        return false;
+    
+    bool synced = syncDescriptor(fileFd);
+    closeDescriptor(fileFd);
+    return synced;
+}
+
+// Publish `source` under the name `target`
+bool CaseJournal::replaceFile(const std::string &source, const std::string &target)
+{
+#ifdef _WIN32
+    // rename() does not overwrite on Windows
+    std::remove(target.c_str());
+#endif
+    return std::rename(source.c_str(), target.c_str()) == 0;
+}
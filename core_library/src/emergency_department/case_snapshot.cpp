@@ -0,0 +1,199 @@
+#include "core_library/emergency_department/case_snapshot.hpp"
+#include "core_library/mapped_file.hpp"
+#include <cstring>
+#include <fstream>
+
+// Fixed-size file header (all offsets are from the start of the file)
+struct SnapshotHeader
+{
+    char magic[8];               // "EDSNAP\r\n"
+    uint32_t version;            // CaseSnapshot::VERSION
+    uint32_t byteOrder;          // BYTE_ORDER_MARK as written by this machine
+    uint32_t caseCount;          // Cases in the file
+    uint32_t nextSequence;       // Queue's next sequence number
+    uint64_t sequencesOffset;    // uint32_t[caseCount]
+    uint64_t epochsOffset;       // int64_t[caseCount]
+    uint64_t levelsOffset;       // uint8_t[caseCount]
+    uint64_t typesOffset;        // uint8_t[caseCount]
+    uint64_t stringEndsOffset;   // uint32_t[caseCount * STRINGS_PER_CASE]
+    uint64_t arenaOffset;        // String bytes
+    uint64_t arenaBytes;         // Length of the arena
+};
+
+static const char MAGIC[8] = { 'E', 'D', 'S', 'N', 'A', 'P', '\r', '\n' };
+static const uint32_t BYTE_ORDER_MARK = 0x01020304u;
+static const int STRINGS_PER_CASE = 5;
+
+// Round a file offset up to the next 8-byte boundary
+static uint64_t align8(uint64_t offset)
+{
+    return (offset + 7) & ~static_cast<uint64_t>(7);
+}
+
+// Does [offset, offset + count * width) lie inside a file of `size` bytes?
+static bool covers(uint64_t size, uint64_t offset, uint64_t count, uint64_t width)
+{
+    return offset <= size && count <= (size - offset) / width;
+}
+
+/* ==================== Write ==================== */
+
+// Write a column, padded so the next one starts 8-byte aligned
+static void writeColumn(std::ofstream &out, const void *column, uint64_t bytes)
+{
+    static const char padding[8] = { 0 };
+    
+    out.write(static_cast<const char *>(column), static_cast<std::streamsize>(bytes));
+    out.write(padding, static_cast<std::streamsize>(align8(bytes) - bytes));
+}
+
+/*
+ * WRITE
+ * Columns are filled in one pass over the queue's storage, then written
+ * one after the other.
+ */
+bool CaseSnapshot::write(const std::string &filename, const PriorityQueue &queue)
+{
+    uint32_t count = static_cast<uint32_t>(queue.getSize());
+    uint32_t *sequences = new uint32_t[count + 1];
+    int64_t *epochs = new int64_t[count + 1];
+    uint8_t *levels = new uint8_t[count + 1];
+    uint8_t *types = new uint8_t[count + 1];
+    uint32_t *stringEnds = new uint32_t[static_cast<size_t>(count) * STRINGS_PER_CASE + 1];
+    std::string arena;
+    arena.reserve(static_cast<size_t>(count) * 48);
+    
+    uint32_t i = 0;
+    bool fits = true;
+    queue.forEachEntry([&](uint64_t key, const EmergencyCase &emergencyCase) {
+        sequences[i] = static_cast<uint32_t>(key & 0xFFFFFFFFu);
+        epochs[i] = static_cast<int64_t>(emergencyCase.arrivalEpoch);
+        levels[i] = static_cast<uint8_t>(emergencyCase.triageLevel);
+        types[i] = static_cast<uint8_t>(emergencyCase.emergencyType);
+        
+        const std::string *fields[STRINGS_PER_CASE] = {
+            &emergencyCase.caseID, &emergencyCase.patientName, &emergencyCase.symptoms,
+            &emergencyCase.arrivalTime, &emergencyCase.arrivalDate
+        };
+        for (int f = 0; f < STRINGS_PER_CASE; f++)
+        {
+            arena += *fields[f];
+            stringEnds[static_cast<size_t>(i) * STRINGS_PER_CASE + f] = static_cast<uint32_t>(arena.size());
+        }
+        if (arena.size() > 0xFFFFFFFFu)
+            fits = false;
+        i++;
+    });
+    
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.caseCount = count;
+    header.nextSequence = queue.getNextSequence();
+    header.sequencesOffset = align8(sizeof(SnapshotHeader));
+    header.epochsOffset = align8(header.sequencesOffset + count * sizeof(uint32_t));
+    header.levelsOffset = align8(header.epochsOffset + count * sizeof(int64_t));
+    header.typesOffset = align8(header.levelsOffset + count);
+    header.stringEndsOffset = align8(header.typesOffset + count);
+    header.arenaOffset = align8(header.stringEndsOffset + static_cast<uint64_t>(count) * STRINGS_PER_CASE * sizeof(uint32_t));
+    header.arenaBytes = arena.size();
+    
+    bool written = false;
+    if (fits)
+    {
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+        if (out.is_open())
+        {
+            writeColumn(out, &header, sizeof(header));
+            writeColumn(out, sequences, count * sizeof(uint32_t));
+            writeColumn(out, epochs, count * sizeof(int64_t));
+            writeColumn(out, levels, count);
+            writeColumn(out, types, count);
+            writeColumn(out, stringEnds, static_cast<uint64_t>(count) * STRINGS_PER_CASE * sizeof(uint32_t));
+            out.write(arena.data(), static_cast<std::streamsize>(arena.size()));
+            out.close();
+            written = !out.fail();
+        }
+    }
+    
+    delete[] sequences;
+    delete[] epochs;
+    delete[] levels;
+    delete[] types;
+    delete[] stringEnds;
+    return written;
+}
+
+/* ==================== Load ==================== */
+
+/*
+ * LOAD
+ * 1. Map the file, check the header and that every column fits
+ * 2. Check every case (levels, types, string offsets) before touching
+ *    the queue, so a damaged file changes nothing
+ * 3. restoreBatch: each case is built in its payload slot from the
+ *    columns, and the engine gets all entries in one bulk insert
+ */
+int CaseSnapshot::load(const std::string &filename, PriorityQueue &queue)
+{
+    MappedFile view;
+    if (!view.open(filename) || view.length() < sizeof(SnapshotHeader))
+        return -1;
+    view.adviseSequential();
+    
+    SnapshotHeader header;
+    std::memcpy(&header, view.bytes(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+        || header.byteOrder != BYTE_ORDER_MARK)
+        return -1;
+    
+    uint64_t count = header.caseCount;
+    if (header.sequencesOffset % 8 != 0 || header.epochsOffset % 8 != 0 || header.stringEndsOffset % 8 != 0
+        || !covers(view.length(), header.sequencesOffset, count, sizeof(uint32_t))
+        || !covers(view.length(), header.epochsOffset, count, sizeof(int64_t))
+        || !covers(view.length(), header.levelsOffset, count, 1)
+        || !covers(view.length(), header.typesOffset, count, 1)
+        || !covers(view.length(), header.stringEndsOffset, count * STRINGS_PER_CASE, sizeof(uint32_t))
+        || !covers(view.length(), header.arenaOffset, header.arenaBytes, 1))
+        return -1;
+    
+    const char *base = view.bytes();
+    const uint32_t *sequences = reinterpret_cast<const uint32_t *>(base + header.sequencesOffset);
+    const int64_t *epochs = reinterpret_cast<const int64_t *>(base + header.epochsOffset);
+    const uint8_t *levels = reinterpret_cast<const uint8_t *>(base + header.levelsOffset);
+    const uint8_t *types = reinterpret_cast<const uint8_t *>(base + header.typesOffset);
+    const uint32_t *stringEnds = reinterpret_cast<const uint32_t *>(base + header.stringEndsOffset);
+    const char *arena = base + header.arenaOffset;
+    
+    uint32_t previousEnd = 0;
+    for (uint64_t i = 0; i < count; i++)
+    {
+        if (levels[i] < RESUSCITATION || levels[i] > NON_URGENT || types[i] > TYPE_C)
+            return -1;
+        for (int f = 0; f < STRINGS_PER_CASE; f++)
+        {
+            uint32_t end = stringEnds[i * STRINGS_PER_CASE + f];
+            if (end < previousEnd || end > header.arenaBytes)
+                return -1;
+            previousEnd = end;
+        }
+    }
+    
+    return queue.restoreBatch(static_cast<int>(count), header.nextSequence,
+        [&](int i, EmergencyCase &slot) {
+            const uint32_t *ends = stringEnds + static_cast<size_t>(i) * STRINGS_PER_CASE;
+            uint32_t start = i == 0 ? 0 : ends[-1];
+            
+            slot.caseID.assign(arena + start, ends[0] - start);
+            slot.patientName.assign(arena + ends[0], ends[1] - ends[0]);
+            slot.symptoms.assign(arena + ends[1], ends[2] - ends[1]);
+            slot.arrivalTime.assign(arena + ends[2], ends[3] - ends[2]);
+            slot.arrivalDate.assign(arena + ends[3], ends[4] - ends[3]);
+            slot.arrivalEpoch = static_cast<time_t>(epochs[i]);
+            slot.triageLevel = static_cast<TriageLevel>(levels[i]);
+            slot.emergencyType = static_cast<EmergencyType>(types[i]);
+            return sequences[i];
+        });
+}
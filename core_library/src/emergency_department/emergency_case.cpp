@@ -1,6 +1,8 @@
 #include "core_library/emergency_department/emergency_case.hpp"
 #include <sstream>
 #include <ctime>
+#include <cstdio>
+#include <charconv>
 #include <iomanip>
 
 // ANSI Color codes
@@ -16,17 +18,18 @@
 EmergencyCase::EmergencyCase()
     : caseID(""), patientName(""), emergencyType(TYPE_C),
       triageLevel(NON_URGENT), symptoms(""), 
-      arrivalTime(""), arrivalDate(""), waitingMinutes(0) {}
+      arrivalTime(""), arrivalDate(""), arrivalEpoch(0) {}
 
 // Parameterized constructor
 EmergencyCase::EmergencyCase(std::string id, std::string name, 
                              EmergencyType type, TriageLevel triage, 
                              std::string symptom)
     : caseID(id), patientName(name), emergencyType(type),
-      triageLevel(triage), symptoms(symptom), waitingMinutes(0)
+      triageLevel(triage), symptoms(symptom)
 {
     arrivalTime = getCurrentTimeString();
     arrivalDate = getCurrentDateString();
+    arrivalEpoch = parseArrivalEpoch(arrivalTime, arrivalDate);
 }
 
 // Display case information with beautiful formatting
@@ -51,6 +54,7 @@ void EmergencyCase::display() const
               << std::setw(43) << (arrivalDate + " " + arrivalTime) <<                                             "║\n";
     std::cout << "║ " << C_BOLD << "Waiting: " << C_RESET;
     
+    int waitingMinutes = getWaitingMinutes();
     if (waitingMinutes > 60)
         std::cout << C_RED;
     else if (waitingMinutes > 30)
@@ -63,18 +67,56 @@ void EmergencyCase::display() const
     std::cout << "╚═══════════════════════════════════════════════════════╝\n";
 }
 
-// Calculate priority score (lower = higher priority)
-// Formula: (triage_level * 100) - (waiting_minutes)
-// This allows priority escalation for cases waiting too long
-int EmergencyCase::getPriorityScore() const
+// Calculate priority key (lower = higher priority)
+// Escalation rule: score = (triage_level * 100) - (waiting_minutes)
+//
+// waiting_minutes = now - arrival, so
+//   score = (triage_level * 100 + arrival) - now
+// Every case shares the "- now" term, so the order only depends on
+// (triage_level * 100 minutes) + arrival, which never changes while a
+// case waits. Each level is therefore worth 100 minutes (6000 seconds)
+// of waiting, and the heap never has to be rebuilt as time passes.
+long long EmergencyCase::getPriorityKey() const
 {
-    int baseScore = static_cast<int>(triageLevel) * 100;
-    
-    // Subtract waiting time to escalate priority
-    // Each minute of waiting reduces score by 1
-    int escalationBonus = waitingMinutes;
-    
-    return baseScore - escalationBonus;
+    return static_cast<long long>(triageLevel) * 6000 
+           + static_cast<long long>(arrivalEpoch);
+}
+
+// Minutes waited since arrival
+int EmergencyCase::getWaitingMinutes() const
+{
+    return getWaitingMinutes(time(nullptr));
+}
+
+int EmergencyCase::getWaitingMinutes(time_t now) const
+{
+    if (now <= arrivalEpoch)
+        return 0;
+    return static_cast<int>((now - arrivalEpoch) / 60);
+}
+
+// Escalation thresholds (in minutes)
+int EmergencyCase::getEscalationThreshold() const
+{
+    switch (triageLevel)
+    {
+        case RESUSCITATION: return 0;    // Immediate
+        case EMERGENCY:     return 10;   // 10 min
+        case URGENT:        return 30;   // 30 min
+        case SEMI_URGENT:   return 60;   // 60 min
+        case NON_URGENT:    return 120;  // 2 hours
+    }
+    return 0;
+}
+
+// A case is overdue once getWaitingMinutes() > threshold, i.e. from
+// arrival + (threshold + 1) minutes on. Resuscitation is seen at once
+// and is never escalated.
+time_t EmergencyCase::getEscalationDeadline() const
+{
+    if (triageLevel == RESUSCITATION)
+        return 0;
+    return arrivalEpoch + static_cast<time_t>(getEscalationThreshold() + 1) * 60;
 }
 
 // Convert to string for file storage (CSV format)
@@ -88,34 +130,38 @@ std::string EmergencyCase::toString() const
        << symptoms << ","
        << arrivalTime << ","
        << arrivalDate << ","
-       << waitingMinutes;
+       << getWaitingMinutes();
     return ss.str();
 }
 
+// File layout: caseID,name,type,triage,symptoms,time,date,waiting
+// (waiting minutes are derived from the arrival, so they are skipped)
+typedef RecordSchema<EmergencyCase,
+                     TextField<&EmergencyCase::caseID>,
+                     TextField<&EmergencyCase::patientName>,
+                     IntField<&EmergencyCase::emergencyType, TYPE_A, TYPE_C>,
+                     IntField<&EmergencyCase::triageLevel, RESUSCITATION, NON_URGENT>,
+                     TextField<&EmergencyCase::symptoms>,
+                     TextField<&EmergencyCase::arrivalTime>,
+                     TextField<&EmergencyCase::arrivalDate>,
+                     SkipField> EmergencyCaseSchema;
+
 // Parse from file string
+bool EmergencyCase::parse(std::string_view line, EmergencyCase& out, RecordError& error)
+{
+    if (!EmergencyCaseSchema::parse(line, out, error))
+        return false;
+    
+    out.arrivalEpoch = parseArrivalEpoch(out.arrivalTime, out.arrivalDate);
+    return true;
+}
+
 EmergencyCase EmergencyCase::fromString(const std::string& line)
 {
     EmergencyCase ec;
-    std::stringstream ss(line);
-    std::string token;
-    int field = 0;
-    
-    while (std::getline(ss, token, ','))
-    {
-        switch(field)
-        {
-            case 0: ec.caseID = token; break;
-            case 1: ec.patientName = token; break;
-            case 2: ec.emergencyType = static_cast<EmergencyType>(std::stoi(token)); break;
-            case 3: ec.triageLevel = static_cast<TriageLevel>(std::stoi(token)); break;
-            case 4: ec.symptoms = token; break;
-            case 5: ec.arrivalTime = token; break;
-            case 6: ec.arrivalDate = token; break;
-            case 7: ec.waitingMinutes = std::stoi(token); break;
-        }
-        field++;
-    }
-    
+    RecordError error;
+    EmergencyCaseSchema::parse(line, ec, error);
+    ec.arrivalEpoch = parseArrivalEpoch(ec.arrivalTime, ec.arrivalDate);
     return ec;
 }
 
@@ -162,15 +208,9 @@ std::string EmergencyCase::getTriageColor() const
 // Comparison operators for priority queue
 bool EmergencyCase::operator<(const EmergencyCase& other) const
 {
-    // Lower priority score = higher priority
-    int thisScore = this->getPriorityScore();
-    int otherScore = other.getPriorityScore();
-    
-    if (thisScore != otherScore)
-        return thisScore < otherScore;  // Lower score = higher priority
-    
-    // If same priority, earlier arrival time = higher priority (FIFO)
-    return this->arrivalTime < other.arrivalTime;
+    // Lower priority key = higher priority
+    // (the key already puts earlier arrivals first within a level)
+    return this->getPriorityKey() < other.getPriorityKey();
 }
 
 bool EmergencyCase::operator>(const EmergencyCase& other) const
@@ -208,30 +248,63 @@ std::string getCurrentDateString()
     return ss.str();
 }
 
-// Calculate waiting time in minutes
-int calculateWaitingTime(const std::string& arrivalTime, const std::string& arrivalDate)
+// Read up to `count` numbers separated by `separator` (returns how many)
+static int readNumbers(const std::string& text, char separator, int values[], int count)
 {
-    // Simple calculation: just return difference in minutes
-    // In real implementation, you'd parse the date/time properly
-    // For now, return a placeholder
-    std::string currentTime = getCurrentTimeString();
-    std::string currentDate = getCurrentDateString();
+    const char *position = text.data();
+    const char *end = text.data() + text.size();
+    int read = 0;
     
-    // Simplified: if same date, calculate time difference
-    if (arrivalDate == currentDate)
+    while (read < count)
     {
-        int arrHour = std::stoi(arrivalTime.substr(0, 2));
-        int arrMin = std::stoi(arrivalTime.substr(3, 2));
+        std::from_chars_result result = std::from_chars(position, end, values[read]);
+        if (result.ec != std::errc())
+            break;
+        read++;
         
-        int currHour = std::stoi(currentTime.substr(0, 2));
-        int currMin = std::stoi(currentTime.substr(3, 2));
+        if (result.ptr == end || *result.ptr != separator)
+            break;
+        position = result.ptr + 1;
+    }
+    return read;
+}
+
+// Convert "HH:MM:SS" + "YYYY-MM-DD" (local time) to seconds since epoch
+// Unparsable input is treated as "arrived now"
+//
+// mktime() applies the time zone rules and is by far the slowest step
+// of loading a case; cases in a file mostly share their arrival hour,
+// so the epoch of the last hour seen is kept and minutes and seconds
+// are added to it
+time_t parseArrivalEpoch(const std::string& arrivalTime, const std::string& arrivalDate)
+{
+    static long long cachedHour = -1;
+    static time_t cachedHourEpoch = 0;
+    
+    int date[3] = { 0, 0, 0 };
+    int clock[3] = { 0, 0, 0 };
+    if (readNumbers(arrivalDate, '-', date, 3) != 3 || readNumbers(arrivalTime, ':', clock, 3) < 2)
+    {
+        return time(nullptr);
+    }
+    
+    long long hour = ((static_cast<long long>(date[0]) * 100 + date[1]) * 100 + date[2]) * 100 + clock[0];
+    if (hour != cachedHour)
+    {
+        tm t = {};
+        t.tm_year = date[0] - 1900;
+        t.tm_mon = date[1] - 1;
+        t.tm_mday = date[2];
+        t.tm_hour = clock[0];
+        t.tm_isdst = -1;
         
-        int totalArrMin = arrHour * 60 + arrMin;
-        int totalCurrMin = currHour * 60 + currMin;
+        time_t epoch = mktime(&t);
+        if (epoch == static_cast<time_t>(-1))
+            return time(nullptr);
         
-        return totalCurrMin - totalArrMin;
+        cachedHour = hour;
+        cachedHourEpoch = epoch;
     }
     
-    // Different date: return large number (simplified)
-    return 1440; // 24 hours
-}
\ No newline at end of file
+    return cachedHourEpoch + clock[1] * 60 + clock[2];
+}
@@ -1,24 +1,49 @@
 #include "core_library/emergency_department/emergency_officer.hpp"
+#include "core_library/emergency_department/case_snapshot.hpp"
+#include "core_library/load_progress.hpp"
+#include "core_library/mapped_file.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <limits>
 #include <chrono>
-#include <thread>
+#include <ctime>
+#include <cctype>
+#include <charconv>
 
 using namespace std;
 
+// Binary snapshot of the waiting cases, the journal of changes since
+// it, and the CSV case file (imported when there is no snapshot yet,
+// written only by the CSV export)
+static const string SNAPSHOT_FILE = "../../data/emergency_cases.snap";
+static const string JOURNAL_FILE = "../../data/emergency_cases.journal";
+static const string CASES_FILE = "../../data/emergency_cases.txt";
+
 // Constructor
 EmergencyOfficer::EmergencyOfficer() : nextCaseNumber(1)
 {
-    loadCasesFromFile("../../data/emergency_cases.txt");
+    // Recovery: snapshot first, then the events logged after it
+    if (!loadSnapshot(SNAPSHOT_FILE))
+        loadCasesFromFile(CASES_FILE);
+    replayJournal(JOURNAL_FILE);
+    if (!journal.open(JOURNAL_FILE))
+    {
+        cout << C_RED << "\n✗ ERROR: " << C_RESET 
+             << "Could not open the case journal, changes are saved on exit only." << endl;
+    }
+    
+    // Cases already overdue in the file are listed by the escalation
+    // check, only new crossings are announced
+    emergencyQueue.advanceEscalations(time(nullptr));
+    emergencyQueue.setEscalationListener(this);
 }
 
 // Destructor
 EmergencyOfficer::~EmergencyOfficer()
 {
-    saveCasesToFile("../../data/emergency_cases.txt");
+    saveSnapshot();
 }
 
 // Generate next case ID
@@ -32,123 +57,233 @@ string EmergencyOfficer::generateNextCaseID()
 
 /* ==================== FILE I/O ==================== */
 
+// Number part of a case ID ("EC0042" -> 42, 0 if there is none)
+static int caseNumberOf(const string& caseID)
+{
+    int caseNum = 0;
+    if (caseID.length() > 2)
+        from_chars(caseID.data() + 2, caseID.data() + caseID.length(), caseNum);
+    return caseNum;
+}
+
+// Map the binary snapshot into the queue (false = no valid snapshot)
+bool EmergencyOfficer::loadSnapshot(const string& filename)
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    
+    int count = CaseSnapshot::load(filename, emergencyQueue);
+    if (count < 0)
+        return false;
+    
+    // Case numbers continue after the highest one in the snapshot
+    int maxCaseNum = 0;
+    emergencyQueue.forEach([&](const EmergencyCase& ec) {
+        int caseNum = caseNumberOf(ec.caseID);
+        if (caseNum > maxCaseNum)
+            maxCaseNum = caseNum;
+    });
+    nextCaseNumber = maxCaseNum + 1;
+    
+    long long micros = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    cout << C_GREEN << "\n✓ SUCCESS: " << C_RESET 
+         << "Loaded " << C_BOLD << count << C_RESET 
+         << " emergency cases from snapshot in " << micros / 1000 << "." 
+         << (micros / 100) % 10 << " ms.\n" << endl;
+    return true;
+}
+
+/*
+ * CSV IMPORT
+ * The file is mapped and its line index built in one vectorized scan;
+ * each line is then parsed from a view into the mapping, straight into
+ * a block of LOAD_BLOCK cases. Each full block goes into the queue
+ * with one enqueueBatch. Progress comes from the byte offset of the
+ * line. Malformed lines are reported and skipped.
+ */
 void EmergencyOfficer::loadCasesFromFile(const string& filename)
 {
-    ifstream file(filename);
+    MappedFile file;
     
-    if (!file.is_open())
+    if (!file.open(filename))
     {
         cout << C_YELLOW << "\n⚠ INFO: " << C_RESET 
              << "No existing emergency cases file. Starting fresh." << endl;
         return;
     }
     
-    string line;
-    int count = 0;
-    int maxCaseNum = 0;
+    uint64_t fileBytes = file.length();
+    if (fileBytes == 0)
+        return;
+    file.adviseSequential();
     
     // Loading bar
     cout << "\n" << C_BOLD << C_CYAN 
          << "🏥 Loading Emergency Cases from Database..." 
          << C_RESET << endl;
     
-    const string spinner[] = {"⠋", "⠙", "⠹", "⠸", "⠼", "⠴", "⠦", "⠧", "⠇", "⠏"};
-    int spinIndex = 0;
-    int total = 0;
-    
-    // Count total lines first
-    {
-        string tmp;
-        while (getline(file, tmp))
-            if (!tmp.empty()) total++;
-        file.clear();
-        file.seekg(0, ios::beg);
-    }
-    
-    if (total == 0)
-    {
-        file.close();
-        return;
-    }
+    const int LOAD_BLOCK = 4096;
+    const int MAX_REPORTED_LINES = 5;
+    EmergencyCase *block = new EmergencyCase[LOAD_BLOCK];
+    int blockCount = 0;
+    int count = 0;
+    int maxCaseNum = 0;
+    int malformed = 0;
+    LoadProgress progress(fileBytes);
     
-    while (getline(file, line))
+    int lineCount = file.indexLines();
+    for (int i = 0; i < lineCount; i++)
     {
+        string_view line = file.line(i);
         if (line.empty()) continue;
         
-        EmergencyCase ec = EmergencyCase::fromString(line);
-        emergencyQueue.enqueue(ec);
-        
-        // Extract case number for auto-increment
-        if (ec.caseID.length() > 2)
+        // Parsed straight into the block slot (its strings are reused)
+        EmergencyCase &ec = block[blockCount];
+        RecordError error;
+        if (!EmergencyCase::parse(line, ec, error))
         {
-            int caseNum = stoi(ec.caseID.substr(2));
-            if (caseNum > maxCaseNum)
-                maxCaseNum = caseNum;
+            if (malformed < MAX_REPORTED_LINES)
+            {
+                cout << "\r" << C_YELLOW << "⚠ Skipped line " << i + 1 << ": field " 
+                     << error.field + 1 << " " << error.reason << C_RESET << endl;
+            }
+            malformed++;
+            continue;
         }
         
-        count++;
-        
-        // Progress bar
-        float progress = (float)count / total;
-        int barWidth = 30;
-        int filled = (int)(progress * barWidth);
+        // Extract case number for auto-increment
+        int caseNum = caseNumberOf(ec.caseID);
+        if (caseNum > maxCaseNum)
+            maxCaseNum = caseNum;
         
-        string bar;
-        for (int i = 0; i < barWidth; ++i)
+        count++;
+        if (++blockCount == LOAD_BLOCK)
         {
-            if (i < filled)
-                bar += "█";
-            else
-                bar += " ";
+            emergencyQueue.enqueueBatch(block, blockCount);
+            blockCount = 0;
         }
-        
-        cout << "\r" << C_BOLD << C_GREEN
-             << spinner[spinIndex % 10] << " [" << bar << "] "
-             << setw(3) << int(progress * 100) << "% " << C_RESET;
-        cout.flush();
-        
-        spinIndex++;
-        std::this_thread::sleep_for(std::chrono::milliseconds(80));
+        progress.update(file.lineEndOffset(i));
     }
     
+    emergencyQueue.enqueueBatch(block, blockCount);
+    delete[] block;
     file.close();
     nextCaseNumber = maxCaseNum + 1;
     
     if (count > 0)
     {
-        cout << "\r" << C_BOLD << C_GREEN
-             << "✅ [██████████████████████████████] 100%" << C_RESET << endl;
+        progress.finish(count, fileBytes);
         cout << C_GREEN << "✓ SUCCESS: " << C_RESET 
              << "Loaded " << C_BOLD << count << C_RESET 
              << " emergency cases.\n" << endl;
     }
+    if (malformed > 0)
+    {
+        cout << C_YELLOW << "⚠ WARNING: " << C_RESET 
+             << malformed << " malformed line(s) in " << filename << " were skipped.\n" << endl;
+    }
 }
 
-void EmergencyOfficer::saveCasesToFile(const string& filename) const
+// Write every waiting case (an empty queue gives an empty file, so
+// treated cases do not come back on the next start)
+bool EmergencyOfficer::saveCasesToFile(const string& filename) const
 {
-    if (emergencyQueue.isEmpty())
-        return;
-    
     ofstream file(filename);
     if (!file.is_open())
     {
         cout << C_RED << "\n✗ ERROR: " << C_RESET 
              << "Could not save data to file!" << endl;
-        return;
+        return false;
     }
     
-    const int MAX_CASES = 100;
-    EmergencyCase cases[MAX_CASES];
-    int count;
+    // Written straight from the queue's storage (no copy of the cases)
+    for (const EmergencyCase& ec : emergencyQueue.cases())
+    {
+        file << ec.toString() << "\n";
+    }
+    
+    file.close();
+    return !file.fail();
+}
+
+/*
+ * REPLAY JOURNAL
+ * Applies the events logged after the snapshot. Replay is idempotent:
+ * a crash between writing a new snapshot and emptying the journal
+ * leaves events the snapshot already holds, and those change nothing
+ * (an already-present case is not logged twice, a missing case cannot
+ * be treated twice).
+ */
+void EmergencyOfficer::replayJournal(const string& filename)
+{
+    int maxCaseNum = nextCaseNumber - 1;
+    
+    int replayed = CaseJournal::replay(filename, [&](const CaseJournal::Record& record) {
+        EmergencyCase existing;
+        switch (record.type)
+        {
+            case 'L':
+                if (!emergencyQueue.findCase(record.caseID, existing))
+                    emergencyQueue.enqueue(record.emergencyCase);
+                
+                // Extract case number for auto-increment
+                if (caseNumberOf(record.caseID) > maxCaseNum)
+                    maxCaseNum = caseNumberOf(record.caseID);
+                break;
+            case 'T':
+            case 'C':
+                emergencyQueue.cancelCase(record.caseID, existing);
+                break;
+            case 'R':
+                emergencyQueue.updateTriage(record.caseID, record.triageLevel);
+                break;
+        }
+    });
     
-    emergencyQueue.getAllCases(cases, count);
+    nextCaseNumber = maxCaseNum + 1;
     
-    for (int i = 0; i < count; i++)
+    if (replayed > 0)
     {
-        file << cases[i].toString() << endl;
+        cout << C_GREEN << "✓ RECOVERED: " << C_RESET 
+             << C_BOLD << replayed << C_RESET 
+             << " journaled changes since the last save.\n" << endl;
     }
+}
+
+/*
+ * COMPACT JOURNAL
+ * 1. Commit pending records
+ * 2. Write the queue to a temporary binary snapshot, fsync it
+ * 3. Rename it over the old snapshot (atomic on POSIX)
+ * 4. Empty the journal
+ * A crash at any point leaves either the old snapshot + full journal
+ * or the new snapshot + a journal that replays to the same queue.
+ */
+bool EmergencyOfficer::compactJournal()
+{
+    journal.commit();
     
-    file.close();
+    string temporary = SNAPSHOT_FILE + ".tmp";
+    if (!CaseSnapshot::write(temporary, emergencyQueue) || !CaseJournal::syncFile(temporary) 
+        || !CaseJournal::replaceFile(temporary, SNAPSHOT_FILE))
+    {
+        cout << C_RED << "\n✗ ERROR: " << C_RESET 
+             << "Could not write the case snapshot, the journal is kept." << endl;
+        return false;
+    }
+    
+    if (journal.isOpen())
+        journal.truncate();
+    return true;
+}
+
+// Compact only when something was journaled since the last compaction
+// (otherwise the snapshot already holds every change)
+bool EmergencyOfficer::saveSnapshot()
+{
+    if (journal.getRecordCount() == 0 && journal.getPendingCount() == 0)
+        return true;
+    
+    return compactJournal();
 }
 
 /* ==================== HELPER FUNCTIONS ==================== */
@@ -283,14 +418,6 @@ void EmergencyOfficer::logEmergencyCase()
          << C_RESET << endl;
     cout << C_CYAN << string(70, '=') << C_RESET << endl;
     
-    // Check if queue is full
-    if (emergencyQueue.isFull())
-    {
-        cout << C_RED << "\n✗ ERROR: " << C_RESET 
-             << "Emergency queue is full! Cannot log new cases." << endl;
-        return;
-    }
-    
     // Auto-generate case ID
     string caseID = generateNextCaseID();
     cout << C_GREEN << "\n✓ Case ID auto-generated: " << C_BOLD 
@@ -333,6 +460,8 @@ void EmergencyOfficer::logEmergencyCase()
     // Add to priority queue
     if (emergencyQueue.enqueue(newCase))
     {
+        journal.logCase(newCase);
+        
         cout << "\n" << C_GREEN << string(70, '=') << C_RESET << endl;
         cout << C_GREEN << C_BOLD << "  ✓ EMERGENCY CASE LOGGED SUCCESSFULLY!" 
              << C_RESET << endl;
@@ -374,9 +503,6 @@ void EmergencyOfficer::processMostCriticalCase()
         return;
     }
     
-    // Update waiting times first
-    emergencyQueue.updateWaitingTimes();
-    
     // Peek at highest priority case
     EmergencyCase criticalCase;
     emergencyQueue.peek(criticalCase);
@@ -403,6 +529,9 @@ void EmergencyOfficer::processMostCriticalCase()
     EmergencyCase processedCase;
     if (emergencyQueue.dequeue(processedCase))
     {
+        recordTreatment(processedCase, time(nullptr));
+        journal.logTreated(processedCase.caseID);
+        
         cout << "\n" << C_GREEN << string(70, '=') << C_RESET << endl;
         cout << C_GREEN << C_BOLD 
              << "  ✓ PATIENT SENT TO TREATMENT!" 
@@ -413,7 +542,7 @@ void EmergencyOfficer::processMostCriticalCase()
         cout << "  Case ID: " << processedCase.caseID << endl;
         cout << "  Patient: " << processedCase.patientName << endl;
         cout << "  Triage: " << processedCase.getTriageLevelName() << endl;
-        cout << "  Total Waiting Time: " << processedCase.waitingMinutes 
+        cout << "  Total Waiting Time: " << processedCase.getWaitingMinutes() 
              << " minutes" << endl;
         
         cout << "\n" << C_CYAN << "📊 Remaining Cases: " 
@@ -442,9 +571,6 @@ void EmergencyOfficer::viewPendingCases()
          << C_RESET << endl;
     cout << C_CYAN << string(70, '=') << C_RESET << endl;
     
-    // Update waiting times before displaying
-    emergencyQueue.updateWaitingTimes();
-    
     if (emergencyQueue.isEmpty())
     {
         cout << C_YELLOW << "\n⚠ INFO: " << C_RESET 
@@ -452,8 +578,26 @@ void EmergencyOfficer::viewPendingCases()
         return;
     }
     
-    // Display all cases in priority order
-    emergencyQueue.display();
+    // Display the queue a page at a time, in priority order
+    const int PAGE_SIZE = 20;
+    int first = 0;
+    
+    while (true)
+    {
+        emergencyQueue.display(first, PAGE_SIZE);
+        first += PAGE_SIZE;
+        
+        if (first >= emergencyQueue.getSize())
+            break;
+        
+        cout << "\n" << C_YELLOW << "N = Next " << PAGE_SIZE 
+             << " cases, Enter = Back: " << C_RESET;
+        string choice;
+        getline(cin, choice);
+        
+        if (choice.empty() || toupper(choice[0]) != 'N')
+            break;
+    }
 }
 
 /* ==================== ADDITIONAL FEATURE 1: PRIORITY ESCALATION ==================== */
@@ -471,45 +615,24 @@ void EmergencyOfficer::checkPriorityEscalation()
         return;
     }
     
-    // Update waiting times
-    emergencyQueue.updateWaitingTimes();
+    // Waiting times are derived from one clock reading
+    time_t now = time(nullptr);
     
-    const int MAX_CASES = 100;
-    EmergencyCase cases[MAX_CASES];
-    int count;
-    emergencyQueue.getAllCases(cases, count);
-    
-    // Check for cases needing escalation
+    // Only cases past their deadline are visited (deadline index)
     int escalatedCount = 0;
     
     cout << "\n" << C_BOLD << "Checking waiting times..." << C_RESET << endl;
     
-    for (int i = 0; i < count; i++)
-    {
-        // Escalation thresholds (in minutes)
-        int threshold = 0;
-        switch(cases[i].triageLevel)
-        {
-            case RESUSCITATION: threshold = 0; break;   // Immediate
-            case EMERGENCY:     threshold = 10; break;  // 10 min
-            case URGENT:        threshold = 30; break;  // 30 min
-            case SEMI_URGENT:   threshold = 60; break;  // 60 min
-            case NON_URGENT:    threshold = 120; break; // 2 hours
-        }
-        
-        if (cases[i].waitingMinutes > threshold && 
-            cases[i].triageLevel != RESUSCITATION)
-        {
-            cout << C_RED << "\n⚠ ESCALATION ALERT:" << C_RESET << endl;
-            cout << "  Case: " << cases[i].caseID 
-                 << " (" << cases[i].patientName << ")" << endl;
-            cout << "  Current Triage: " << cases[i].getTriageLevelName() 
-                 << endl;
-            cout << "  Waiting: " << cases[i].waitingMinutes 
-                 << " minutes (Threshold: " << threshold << " min)" << endl;
-            escalatedCount++;
-        }
-    }
+    emergencyQueue.forEachOverdue(now, [&](const EmergencyCase& ec) {
+        cout << C_RED << "\n⚠ ESCALATION ALERT:" << C_RESET << endl;
+        cout << "  Case: " << ec.caseID 
+             << " (" << ec.patientName << ")" << endl;
+        cout << "  Current Triage: " << ec.getTriageLevelName() 
+             << endl;
+        cout << "  Waiting: " << ec.getWaitingMinutes(now) 
+             << " minutes (Threshold: " << ec.getEscalationThreshold() << " min)" << endl;
+        escalatedCount++;
+    });
     
     if (escalatedCount == 0)
     {
@@ -523,6 +646,16 @@ void EmergencyOfficer::checkPriorityEscalation()
     }
 }
 
+// Called by the queue once per case, when it becomes overdue
+void EmergencyOfficer::onEscalation(const EmergencyCase& emergencyCase, time_t now)
+{
+    cout << C_RED << C_BOLD << "⚠ Escalation: " << C_RESET << C_RED
+         << emergencyCase.caseID << " (" << emergencyCase.patientName << ", "
+         << emergencyCase.getTriageLevelName() << ") has waited "
+         << emergencyCase.getWaitingMinutes(now) << " min, threshold "
+         << emergencyCase.getEscalationThreshold() << " min" << C_RESET << endl;
+}
+
 /* ==================== ADDITIONAL FEATURE 2: SEARCH CASE ==================== */
 
 void EmergencyOfficer::searchCase()
@@ -547,6 +680,16 @@ void EmergencyOfficer::searchCase()
     {
         cout << "\n" << C_GREEN << "✓ Case found!" << C_RESET << endl;
         foundCase.display();
+        
+        cout << "\n" << C_YELLOW 
+             << "R = Re-triage, C = Cancel case, Enter = Back: " << C_RESET;
+        string action;
+        getline(cin, action);
+        
+        if (!action.empty() && toupper(action[0]) == 'R')
+            applyRetriage(searchID);
+        else if (!action.empty() && toupper(action[0]) == 'C')
+            applyCancellation(searchID);
     }
     else
     {
@@ -555,8 +698,145 @@ void EmergencyOfficer::searchCase()
     }
 }
 
+// Change the triage level of a waiting case
+void EmergencyOfficer::applyRetriage(const string& caseID)
+{
+    EmergencyCase current;
+    if (!emergencyQueue.findCase(caseID, current))
+    {
+        cout << C_RED << "\n✗ Case ID not found: " << caseID 
+             << C_RESET << endl;
+        return;
+    }
+    
+    cout << "\nCurrent Triage: " << current.getTriageColor() 
+         << current.getTriageLevelName() << C_RESET << endl;
+    
+    displayTriageInfo();
+    TriageLevel newLevel = selectTriageLevel();
+    
+    if (newLevel == current.triageLevel)
+    {
+        cout << C_YELLOW << "\n⚠ Triage level unchanged." << C_RESET << endl;
+        return;
+    }
+    
+    emergencyQueue.updateTriage(caseID, newLevel);
+    journal.logRetriage(caseID, newLevel);
+    
+    EmergencyCase updated;
+    emergencyQueue.findCase(caseID, updated);
+    cout << C_GREEN << "\n✓ " << caseID << " re-triaged: " << C_RESET 
+         << current.getTriageLevelName() << " → " << updated.getTriageColor()
+         << updated.getTriageLevelName() << C_RESET << endl;
+    
+    EmergencyCase highestPriority;
+    emergencyQueue.peek(highestPriority);
+    if (highestPriority.caseID == caseID)
+    {
+        cout << C_RED << C_BOLD 
+             << "   ⚠ ALERT: This is now the HIGHEST PRIORITY case!" 
+             << C_RESET << endl;
+    }
+}
+
+// Remove a case that left without being seen
+void EmergencyOfficer::applyCancellation(const string& caseID)
+{
+    EmergencyCase found;
+    if (!emergencyQueue.findCase(caseID, found))
+    {
+        cout << C_RED << "\n✗ Case ID not found: " << caseID 
+             << C_RESET << endl;
+        return;
+    }
+    
+    cout << "\n" << C_YELLOW << "Cancel " << caseID << " (" << found.patientName 
+         << ")? (Y/N): " << C_RESET;
+    char confirm;
+    cin >> confirm;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    
+    if (toupper(confirm) != 'Y')
+    {
+        cout << C_YELLOW << "\n✓ Case kept in queue." << C_RESET << endl;
+        return;
+    }
+    
+    EmergencyCase cancelled;
+    emergencyQueue.cancelCase(caseID, cancelled);
+    journal.logCancelled(caseID);
+    
+    cout << C_GREEN << "\n✓ Case " << cancelled.caseID << " (" 
+         << cancelled.patientName << ") removed after waiting " 
+         << cancelled.getWaitingMinutes() << " minutes." << C_RESET << endl;
+    cout << "Remaining cases: " << emergencyQueue.getSize() << endl;
+}
+
 /* ==================== ADDITIONAL FEATURE 3: STATISTICS DASHBOARD ==================== */
 
+// Count a treated case's door-to-treatment time (O(1), no allocation)
+void EmergencyOfficer::recordTreatment(const EmergencyCase& treatedCase, time_t now)
+{
+    long long seconds = static_cast<long long>(now - treatedCase.arrivalEpoch);
+    waitByLevel[treatedCase.triageLevel - 1].record(seconds);
+    waitByType[treatedCase.emergencyType].record(seconds);
+}
+
+// One table row: count and p50 / p90 / p99 / p99.9 in minutes
+static void writePercentileRow(ostream& out, const string& label, const WaitHistogram& histogram)
+{
+    out << "  " << left << setw(28) << label << right << setw(7) << histogram.getCount();
+    
+    const double percentiles[4] = { 50.0, 90.0, 99.0, 99.9 };
+    for (int i = 0; i < 4; i++)
+    {
+        if (histogram.getCount() == 0)
+            out << setw(9) << "-";
+        else
+            out << setw(9) << fixed << setprecision(1)
+                << histogram.valueAtPercentile(percentiles[i]) / 60.0;
+    }
+    out << "\n";
+}
+
+// Percentile table of door-to-treatment times (treated this session)
+void EmergencyOfficer::writeWaitPercentiles(ostream& out) const
+{
+    static const char *levelLabels[5] = {
+        "Level 1 (Resuscitation)", "Level 2 (Emergency)", "Level 3 (Urgent)",
+        "Level 4 (Semi-Urgent)", "Level 5 (Non-Urgent)"
+    };
+    static const char *typeLabels[3] = {
+        "Type A (Cardiac/Respiratory)", "Type B (Trauma/Accident)", "Type C (Medical Condition)"
+    };
+    
+    // Formatting below is sticky, restore the stream's own afterwards
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    
+    WaitHistogram all;
+    for (int l = 0; l < 5; l++)
+    {
+        all.add(waitByLevel[l]);
+    }
+    
+    out << "  " << left << setw(28) << "Door-to-treatment (min)" << right << setw(7) << "n"
+        << setw(9) << "p50" << setw(9) << "p90" << setw(9) << "p99" << setw(9) << "p99.9" << "\n";
+    for (int l = 0; l < 5; l++)
+    {
+        writePercentileRow(out, levelLabels[l], waitByLevel[l]);
+    }
+    for (int t = 0; t < 3; t++)
+    {
+        writePercentileRow(out, typeLabels[t], waitByType[t]);
+    }
+    writePercentileRow(out, "All treated cases", all);
+    
+    out.flags(flags);
+    out.precision(precision);
+}
+
 void EmergencyOfficer::displayDashboard()
 {
     cout << "\n" << C_CYAN << string(70, '=') << C_RESET << endl;
@@ -568,51 +848,43 @@ void EmergencyOfficer::displayDashboard()
     {
         cout << C_GREEN << "\n✓ No pending cases. Department clear!" 
              << C_RESET << endl;
+        
+        cout << "\n" << C_BOLD << "⏱ TREATED THIS SESSION:" << C_RESET << endl;
+        writeWaitPercentiles(cout);
         return;
     }
     
-    const int MAX_CASES = 100;
-    EmergencyCase cases[MAX_CASES];
-    int count;
-    emergencyQueue.getAllCases(cases, count);
-    
-    // Count by triage level
-    int countByTriage[6] = {0}; // Index 0 unused, 1-5 for triage levels
-    int countByType[3] = {0};   // TYPE_A, TYPE_B, TYPE_C
-    int totalWaitTime = 0;
-    int maxWaitTime = 0;
-    
-    for (int i = 0; i < count; i++)
-    {
-        countByTriage[cases[i].triageLevel]++;
-        countByType[cases[i].emergencyType]++;
-        totalWaitTime += cases[i].waitingMinutes;
-        if (cases[i].waitingMinutes > maxWaitTime)
-            maxWaitTime = cases[i].waitingMinutes;
-    }
+    // Counts and wait totals are kept up to date by the queue (no scan)
+    int count = emergencyQueue.getSize();
+    time_t now = time(nullptr);
+    long long totalWaitSeconds = emergencyQueue.totalWaitingSeconds(now);
+    int maxWaitTime = emergencyQueue.longestWaitMinutes(now);
     
     cout << "\n" << C_BOLD << "📊 QUEUE STATISTICS:" << C_RESET << endl;
     cout << "  Total Pending Cases: " << C_BOLD << count << C_RESET << endl;
-    cout << "  Average Wait Time: " << (count > 0 ? totalWaitTime/count : 0) 
+    cout << "  Average Wait Time: " << (count > 0 ? totalWaitSeconds / 60 / count : 0) 
          << " minutes" << endl;
     cout << "  Longest Wait: " << maxWaitTime << " minutes" << endl;
     
     cout << "\n" << C_BOLD << "📋 BY TRIAGE LEVEL:" << C_RESET << endl;
     cout << "  " << C_RED << "Level 1 (Resuscitation): " << C_RESET 
-         << countByTriage[1] << endl;
+         << emergencyQueue.countAtLevel(RESUSCITATION) << endl;
     cout << "  " << C_RED << "Level 2 (Emergency):     " << C_RESET 
-         << countByTriage[2] << endl;
+         << emergencyQueue.countAtLevel(EMERGENCY) << endl;
     cout << "  " << C_YELLOW << "Level 3 (Urgent):        " << C_RESET 
-         << countByTriage[3] << endl;
+         << emergencyQueue.countAtLevel(URGENT) << endl;
     cout << "  " << C_YELLOW << "Level 4 (Semi-Urgent):   " << C_RESET 
-         << countByTriage[4] << endl;
+         << emergencyQueue.countAtLevel(SEMI_URGENT) << endl;
     cout << "  " << C_GREEN << "Level 5 (Non-Urgent):    " << C_RESET 
-         << countByTriage[5] << endl;
+         << emergencyQueue.countAtLevel(NON_URGENT) << endl;
     
     cout << "\n" << C_BOLD << "🏥 BY EMERGENCY TYPE:" << C_RESET << endl;
-    cout << "  Type A (Cardiac/Respiratory): " << countByType[0] << endl;
-    cout << "  Type B (Trauma/Accident):     " << countByType[1] << endl;
-    cout << "  Type C (Medical Condition):   " << countByType[2] << endl;
+    cout << "  Type A (Cardiac/Respiratory): " << emergencyQueue.countOfType(TYPE_A) << endl;
+    cout << "  Type B (Trauma/Accident):     " << emergencyQueue.countOfType(TYPE_B) << endl;
+    cout << "  Type C (Medical Condition):   " << emergencyQueue.countOfType(TYPE_C) << endl;
+    
+    cout << "\n" << C_BOLD << "⏱ TREATED THIS SESSION:" << C_RESET << endl;
+    writeWaitPercentiles(cout);
     
     cout << "\n" << C_CYAN << string(70, '=') << C_RESET << endl;
 }
@@ -665,6 +937,8 @@ void EmergencyOfficer::batchProcessCases()
         EmergencyCase processedCase;
         if (emergencyQueue.dequeue(processedCase))
         {
+            recordTreatment(processedCase, time(nullptr));
+            journal.logTreated(processedCase.caseID);
             cout << "\n" << C_GREEN << "✓ Case " << (i+1) << "/" 
                  << numberToProcess << " - " << processedCase.caseID 
                  << " (" << processedCase.patientName << ") processed." 
@@ -708,32 +982,178 @@ void EmergencyOfficer::exportCasesToFile()
     file << "  Time: " << getCurrentTimeString() << "\n";
     file << "===================================\n\n";
     
-    const int MAX_CASES = 100;
-    EmergencyCase cases[MAX_CASES];
-    int count;
-    emergencyQueue.getAllCases(cases, count);
+    file << "Total Pending Cases: " << emergencyQueue.getSize() << "\n\n";
     
-    file << "Total Pending Cases: " << count << "\n\n";
+    time_t now = time(nullptr);
+    int caseNumber = 1;
     
-    for (int i = 0; i < count; i++)
+    for (const EmergencyCase& ec : emergencyQueue.cases())
     {
-        file << "Case " << (i+1) << ":\n";
-        file << "  ID: " << cases[i].caseID << "\n";
-        file << "  Patient: " << cases[i].patientName << "\n";
-        file << "  Triage: " << cases[i].getTriageLevelName() << "\n";
-        file << "  Type: " << cases[i].getEmergencyTypeName() << "\n";
-        file << "  Symptoms: " << cases[i].symptoms << "\n";
-        file << "  Arrival: " << cases[i].arrivalDate << " " 
-             << cases[i].arrivalTime << "\n";
-        file << "  Waiting: " << cases[i].waitingMinutes << " minutes\n\n";
+        file << "Case " << caseNumber++ << ":\n";
+        file << "  ID: " << ec.caseID << "\n";
+        file << "  Patient: " << ec.patientName << "\n";
+        file << "  Triage: " << ec.getTriageLevelName() << "\n";
+        file << "  Type: " << ec.getEmergencyTypeName() << "\n";
+        file << "  Symptoms: " << ec.symptoms << "\n";
+        file << "  Arrival: " << ec.arrivalDate << " " 
+             << ec.arrivalTime << "\n";
+        file << "  Waiting: " << ec.getWaitingMinutes(now) << " minutes\n\n";
     }
     
+    file << "===================================\n";
+    file << "  TREATED THIS SESSION\n";
+    file << "===================================\n";
+    writeWaitPercentiles(file);
+    
     file.close();
     
     cout << C_GREEN << "\n✓ Report exported successfully!" << C_RESET << endl;
     cout << "Location: " << C_BOLD << filename << C_RESET << endl;
 }
 
+/* ==================== ADDITIONAL FEATURE 7: RE-TRIAGE CASE ==================== */
+
+void EmergencyOfficer::retriageCase()
+{
+    cout << "\n" << C_CYAN << string(70, '=') << C_RESET << endl;
+    cout << C_BOLD << C_CYAN << "           RE-TRIAGE EMERGENCY CASE" 
+         << C_RESET << endl;
+    cout << C_CYAN << string(70, '=') << C_RESET << endl;
+    
+    if (emergencyQueue.isEmpty())
+    {
+        cout << C_YELLOW << "\n⚠ No cases in queue." << C_RESET << endl;
+        return;
+    }
+    
+    cout << "\n" << C_YELLOW << "Enter Case ID to re-triage: " << C_RESET;
+    string caseID;
+    getline(cin, caseID);
+    
+    applyRetriage(caseID);
+}
+
+/* ==================== ADDITIONAL FEATURE 8: CANCEL CASE ==================== */
+
+void EmergencyOfficer::cancelPendingCase()
+{
+    cout << "\n" << C_CYAN << string(70, '=') << C_RESET << endl;
+    cout << C_BOLD << C_CYAN << "           CANCEL CASE (LEFT WITHOUT BEING SEEN)" 
+         << C_RESET << endl;
+    cout << C_CYAN << string(70, '=') << C_RESET << endl;
+    
+    if (emergencyQueue.isEmpty())
+    {
+        cout << C_YELLOW << "\n⚠ No cases in queue." << C_RESET << endl;
+        return;
+    }
+    
+    cout << "\n" << C_YELLOW << "Enter Case ID to cancel: " << C_RESET;
+    string caseID;
+    getline(cin, caseID);
+    
+    applyCancellation(caseID);
+}
+
+/* ==================== ADDITIONAL FEATURE 9: MASS-CASUALTY INTAKE ==================== */
+
+void EmergencyOfficer::massCasualtyIntake()
+{
+    cout << "\n" << C_CYAN << string(70, '=') << C_RESET << endl;
+    cout << C_BOLD << C_CYAN << "           MASS-CASUALTY INTAKE" 
+         << C_RESET << endl;
+    cout << C_CYAN << string(70, '=') << C_RESET << endl;
+    
+    int numberOfPatients;
+    cout << "\n" << C_YELLOW << "Number of patients arriving (1-" 
+         << MAX_INTAKE_PATIENTS << "): " << C_RESET;
+    if (!(cin >> numberOfPatients) || numberOfPatients <= 0 ||
+        numberOfPatients > MAX_INTAKE_PATIENTS)
+    {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << C_RED << "Invalid number." << C_RESET << endl;
+        return;
+    }
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    
+    // One incident: shared emergency type and description
+    displayEmergencyTypeInfo();
+    EmergencyType type = selectEmergencyType();
+    
+    string incident;
+    cout << "\n" << C_YELLOW << "Incident description: " << C_RESET;
+    getline(cin, incident);
+    
+    displayTriageInfo();
+    
+    EmergencyCase *patients = new EmergencyCase[numberOfPatients];
+    int countPerLevel[6] = {0};
+    
+    for (int i = 0; i < numberOfPatients; i++)
+    {
+        cout << "\n" << C_BOLD << "Patient " << (i + 1) << "/" 
+             << numberOfPatients << C_RESET << endl;
+        
+        string patientName;
+        cout << C_YELLOW << "Patient Name (Enter = Unidentified): " << C_RESET;
+        getline(cin, patientName);
+        patientName.erase(0, patientName.find_first_not_of(" \t"));
+        patientName.erase(patientName.find_last_not_of(" \t") + 1);
+        
+        string caseID = generateNextCaseID();
+        if (patientName.empty())
+            patientName = "Unidentified " + caseID;
+        
+        TriageLevel triage = selectTriageLevel();
+        countPerLevel[triage]++;
+        
+        patients[i] = EmergencyCase(caseID, patientName, type, triage, incident);
+    }
+    
+    // Whole group goes into the queue in one call
+    int added = emergencyQueue.enqueueBatch(patients, numberOfPatients);
+    for (int i = 0; i < added; i++)
+    {
+        journal.logCase(patients[i]);
+    }
+    delete[] patients;
+    
+    cout << "\n" << C_GREEN << string(70, '=') << C_RESET << endl;
+    cout << C_GREEN << C_BOLD << "  ✓ " << added << " CASES LOGGED" 
+         << C_RESET << endl;
+    cout << C_GREEN << string(70, '=') << C_RESET << endl;
+    
+    cout << "\n" << C_BOLD << "By triage level:" << C_RESET << endl;
+    for (int level = 1; level <= 5; level++)
+    {
+        if (countPerLevel[level] > 0)
+        {
+            EmergencyCase sample;
+            sample.triageLevel = static_cast<TriageLevel>(level);
+            cout << "   " << left << setw(16) << sample.getTriageLevelName() 
+                 << countPerLevel[level] << endl;
+        }
+    }
+    
+    cout << "\n" << C_CYAN << "📊 Current Queue Status:" << C_RESET << endl;
+    cout << "   Total pending cases: " << C_BOLD 
+         << emergencyQueue.getSize() << C_RESET << endl;
+}
+
+/* ==================== ADDITIONAL FEATURE 10: CSV EXPORT ==================== */
+
+// Write the waiting cases to the readable CSV file on request (exit
+// only writes the binary snapshot)
+void EmergencyOfficer::exportCasesToCsv()
+{
+    if (saveCasesToFile(CASES_FILE))
+    {
+        cout << C_GREEN << "\n✓ " << emergencyQueue.getSize() 
+             << " waiting case(s) written to emergency_cases.txt" << C_RESET << endl;
+    }
+}
+
 /* ==================== MENU AND MAIN LOOP ==================== */
 
 void EmergencyOfficer::displayMenu()
@@ -758,6 +1178,10 @@ void EmergencyOfficer::displayMenu()
     cout << "  " << C_CYAN << "7." << C_RESET << " Triage Guidelines\n";
     cout << "  " << C_CYAN << "8." << C_RESET << " Batch Process Cases\n";
     cout << "  " << C_CYAN << "9." << C_RESET << " Export Report\n";
+    cout << "  " << C_CYAN << "10." << C_RESET << " Re-Triage Case\n";
+    cout << "  " << C_CYAN << "11." << C_RESET << " Cancel Case (Left Without Being Seen)\n";
+    cout << "  " << C_CYAN << "12." << C_RESET << " Mass-Casualty Intake\n";
+    cout << "  " << C_CYAN << "13." << C_RESET << " Export Cases as CSV\n";
     cout << "  " << C_RED << "0." << C_RESET << " Exit & Save\n";
     
     cout << C_BOLD << C_BLUE << string(70, '=') << C_RESET << endl;
@@ -771,13 +1195,16 @@ void EmergencyOfficer::run()
     
     while (running)
     {
+        // Announce cases that crossed their deadline since the last menu
+        emergencyQueue.advanceEscalations(time(nullptr));
+        
         displayMenu();
         
         if (!(cin >> choice))
         {
             cin.clear();
             cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            cout << C_RED << "\n✗ Invalid input! Please enter 0-9." 
+            cout << C_RED << "\n✗ Invalid input! Please enter 0-13." 
                  << C_RESET << endl;
             continue;
         }
@@ -813,23 +1240,43 @@ void EmergencyOfficer::run()
             case 9:
                 exportCasesToFile();
                 break;
+            case 10:
+                retriageCase();
+                break;
+            case 11:
+                cancelPendingCase();
+                break;
+            case 12:
+                massCasualtyIntake();
+                break;
+            case 13:
+                exportCasesToCsv();
+                break;
             case 0:
                 cout << "\n" << C_YELLOW << "Saving emergency cases..." 
                      << C_RESET << endl;
-                saveCasesToFile("../../data/emergency_cases.txt");
-                cout << C_GREEN 
-                     << "\n✓ Data saved successfully to emergency_cases.txt" 
-                     << C_RESET << endl;
+                // Snapshot for the next start (the CSV is option 13)
+                if (saveSnapshot())
+                {
+                    cout << C_GREEN 
+                         << "\n✓ Data saved successfully to emergency_cases.snap" 
+                         << C_RESET << endl;
+                }
                 cout << C_GREEN 
                      << "\n✓ Thank you for using Emergency Department System!" 
                      << C_RESET << endl;
                 running = false;
                 break;
             default:
-                cout << C_RED << "\n✗ Invalid choice! Please select 0-9." 
+                cout << C_RED << "\n✗ Invalid choice! Please select 0-13." 
                      << C_RESET << endl;
         }
         
+        // One group commit per action; snapshot once the journal is long
+        journal.commit();
+        if (journal.getRecordCount() >= COMPACT_EVERY)
+            compactJournal();
+        
         if (running)
         {
             cout << "\n" << C_YELLOW << "Press Enter to continue..." 
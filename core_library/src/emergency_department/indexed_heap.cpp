@@ -0,0 +1,311 @@
+#include "core_library/emergency_department/indexed_heap.hpp"
+#include "core_library/emergency_department/frontier_heap.hpp"
+
+// Constructor
+IndexedHeap::IndexedHeap()
+    : heap(nullptr), heapCapacity(0), size(0), position(nullptr), handleCapacity(0) {}
+
+// Destructor
+IndexedHeap::~IndexedHeap()
+{
+    delete[] heap;
+    delete[] position;
+}
+
+// Grow the entry array (entries are plain integers, cheap to copy)
+void IndexedHeap::reserve(int capacity)
+{
+    if (capacity <= heapCapacity)
+        return;
+    
+    int newCapacity = heapCapacity == 0 ? 16 : heapCapacity;
+    while (newCapacity < capacity)
+        newCapacity *= 2;
+    
+    Entry *newHeap = new Entry[newCapacity];
+    for (int i = 0; i < size; i++)
+    {
+        newHeap[i] = heap[i];
+    }
+    delete[] heap;
+    heap = newHeap;
+    heapCapacity = newCapacity;
+}
+
+// Grow the position table
+void IndexedHeap::reserveHandles(int capacity)
+{
+    if (capacity <= handleCapacity)
+        return;
+    
+    int newCapacity = handleCapacity == 0 ? 16 : handleCapacity;
+    while (newCapacity < capacity)
+        newCapacity *= 2;
+    
+    int *newPosition = new int[newCapacity];
+    for (int i = 0; i < handleCapacity; i++)
+    {
+        newPosition[i] = position[i];
+    }
+    for (int i = handleCapacity; i < newCapacity; i++)
+    {
+        newPosition[i] = -1;
+    }
+    delete[] position;
+    position = newPosition;
+    handleCapacity = newCapacity;
+}
+
+/*
+ * HEAPIFY UP (Bubble Up)
+ * Called after insertion to maintain min-heap property
+ * 
+ * Process:
+ * 1. Compare new element with parent
+ * 2. If new element has higher priority (lower value), move parent down
+ * 3. Repeat until heap property satisfied or reach root
+ * 4. Write the new element once into the remaining hole
+ * 
+ * Example:
+ *        5              3  (after heapifyUp)
+ *       / \            / \
+ *      7   6    →     5   6
+ *     /              /
+ *    3              7
+ */
+void IndexedHeap::heapifyUp(int index)
+{
+    // Lift the entry out, leaving a "hole" at index
+    Entry moving = heap[index];
+    
+    // Pull parents down into the hole while they have lower priority
+    // (remember: lower key = higher priority)
+    while (index > 0 && moving.key < heap[parent(index)].key)
+    {
+        place(index, heap[parent(index)]);
+        index = parent(index);
+    }
+    
+    // Drop the entry into its final place (one move)
+    place(index, moving);
+}
+
+/*
+ * HEAPIFY DOWN (Bubble Down)
+ * Called after removal to maintain min-heap property
+ * 
+ * Process:
+ * 1. Compare root with its children
+ * 2. Find the child with highest priority (smallest value)
+ * 3. If child has higher priority, move it up into the hole
+ * 4. Repeat for the subtree until heap property satisfied
+ * 5. Write the element once into the remaining hole
+ * 
+ * Example:
+ *        7              3  (after heapifyDown)
+ *       / \            / \
+ *      3   6    →     7   6
+ *     /              /
+ *    5              5
+ */
+void IndexedHeap::heapifyDown(int index)
+{
+    // Lift the entry out, leaving a "hole" at index
+    Entry moving = heap[index];
+    
+    while (leftChild(index) < size)
+    {
+        int left = leftChild(index);
+        int right = rightChild(index);
+        int highest = left;  // Child with highest priority (lowest key)
+        
+        // Check if right child has higher priority
+        if (right < size && heap[right].key < heap[left].key)
+            highest = right;
+        
+        // Stop once the moving entry beats both children
+        if (moving.key <= heap[highest].key)
+            break;
+        
+        // Pull the child up into the hole
+        place(index, heap[highest]);
+        index = highest;
+    }
+    
+    // Drop the entry into its final place (one move)
+    place(index, moving);
+}
+
+/*
+ * PUSH (Insert)
+ * 
+ * Algorithm:
+ * 1. Add entry at end of array (maintain complete tree)
+ * 2. Heapify up to restore heap property
+ * 
+ * Time Complexity: O(log n)
+ */
+void IndexedHeap::push(uint64_t key, int handle, int /*level*/)
+{
+    reserve(size + 1);
+    reserveHandles(handle + 1);
+    
+    Entry entry = { key, handle };
+    place(size, entry);
+    heapifyUp(size);
+    size++;
+}
+
+/*
+ * PUSH BATCH (Bulk insert)
+ * 
+ * Algorithm (batch large next to the heap):
+ * 1. Append every entry at the end of the array
+ * 2. Heapify bottom-up: sift down each parent, last one first
+ * A small batch is pushed entry by entry instead.
+ * 
+ * Time Complexity: O(n + k), or O(k log n) for a small batch
+ */
+void IndexedHeap::pushBatch(const uint64_t keys[], const int handles[], const int levels[], int count)
+{
+    if (count <= 0)
+        return;
+    
+    if (count * 4 < size)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            push(keys[i], handles[i], levels[i]);
+        }
+        return;
+    }
+    
+    reserve(size + count);
+    for (int i = 0; i < count; i++)
+    {
+        reserveHandles(handles[i] + 1);
+        Entry entry = { keys[i], handles[i] };
+        place(size + i, entry);
+    }
+    size += count;
+    
+    for (int i = parent(size - 1); i >= 0; i--)
+    {
+        heapifyDown(i);
+    }
+}
+
+// Remove the root (highest priority)
+void IndexedHeap::pop()
+{
+    removeAt(0);
+}
+
+// Remove the entry of a handle
+void IndexedHeap::erase(int handle)
+{
+    if (contains(handle))
+        removeAt(position[handle]);
+}
+
+/*
+ * REMOVE AT (any heap index)
+ * 
+ * Algorithm:
+ * 1. Move last entry into the gap
+ * 2. Heapify up or down, depending on the moved entry's key
+ * 
+ * Time Complexity: O(log n)
+ */
+void IndexedHeap::removeAt(int index)
+{
+    position[heap[index].handle] = -1;
+    
+    size--;
+    if (index == size)
+        return;
+    
+    place(index, heap[size]);
+    
+    if (index > 0 && heap[index].key < heap[parent(index)].key)
+        heapifyUp(index);
+    else
+        heapifyDown(index);
+}
+
+/*
+ * CHANGE KEY
+ * Overwrite the entry's key where it sits, then sift toward the root
+ * (key decreased) or toward the leaves (key increased).
+ * 
+ * Time Complexity: O(log n)
+ */
+void IndexedHeap::changeKey(int handle, uint64_t key, int /*level*/)
+{
+    int index = position[handle];
+    uint64_t oldKey = heap[index].key;
+    heap[index].key = key;
+    
+    if (key < oldKey)
+        heapifyUp(index);
+    else
+        heapifyDown(index);
+}
+
+/*
+ * TOP K (Ordered view without modifying the heap)
+ * 
+ * Algorithm:
+ * 1. Frontier = { root }
+ * 2. Pop the smallest frontier node, report it, add its two children
+ * 3. Repeat K times
+ * 
+ * Time Complexity: O(K log K)
+ */
+int IndexedHeap::topK(int k, int out[]) const
+{
+    if (k > size)
+        k = size;
+    if (k <= 0)
+        return 0;
+    
+    FrontierHeap frontier(k + 1);
+    frontier.push(heap[0].key, 0);
+    
+    int count = 0;
+    while (count < k)
+    {
+        int index = frontier.pop();
+        out[count++] = heap[index].handle;
+        
+        if (leftChild(index) < size)
+            frontier.push(heap[leftChild(index)].key, leftChild(index));
+        if (rightChild(index) < size)
+            frontier.push(heap[rightChild(index)].key, rightChild(index));
+    }
+    return count;
+}
+
+// Rename handles after the owner compacted its payload slots
+void IndexedHeap::remapHandles(const int *newHandleOf)
+{
+    for (int i = 0; i < handleCapacity; i++)
+    {
+        position[i] = -1;
+    }
+    for (int i = 0; i < size; i++)
+    {
+        heap[i].handle = newHandleOf[heap[i].handle];
+        position[heap[i].handle] = i;
+    }
+}
+
+// Remove every entry
+void IndexedHeap::clear()
+{
+    for (int i = 0; i < size; i++)
+    {
+        position[heap[i].handle] = -1;
+    }
+    size = 0;
+}
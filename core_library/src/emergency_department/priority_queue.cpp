@@ -10,105 +10,253 @@
 #define C_CYAN "\033[36m"
 #define C_BOLD "\033[1m"
 
+long long PriorityQueue::caseCopies = 0;
+
 // Constructor
-PriorityQueue::PriorityQueue() : size(0) {}
+PriorityQueue::PriorityQueue()
+    : nextSequence(0),
+      chunks(nullptr), chunkCount(0), directoryCapacity(0), slotCount(0),
+      freeSlots(nullptr), freeCount(0), freeCapacity(0),
+      indexSlots(nullptr), indexHashes(nullptr), indexCapacity(0), indexCount(0),
+      escalationListener(nullptr)
+{
+    statsReset();
+}
 
-// Check if empty
-bool PriorityQueue::isEmpty() const
+// Copy constructor
+PriorityQueue::PriorityQueue(const PriorityQueue &other)
+    : nextSequence(0),
+      chunks(nullptr), chunkCount(0), directoryCapacity(0), slotCount(0),
+      freeSlots(nullptr), freeCount(0), freeCapacity(0),
+      indexSlots(nullptr), indexHashes(nullptr), indexCapacity(0), indexCount(0),
+      escalationListener(nullptr)
 {
-    return size == 0;
+    statsReset();
+    *this = other;
 }
 
-// Check if full
-bool PriorityQueue::isFull() const
+// Copy assignment (cases are re-packed into slots 0..size-1)
+PriorityQueue &PriorityQueue::operator=(const PriorityQueue &other)
 {
-    return size >= MAX_SIZE;
+    if (this != &other)
+    {
+        clear();
+        reserve(other.getSize());
+        
+        other.engine.forEach([&](uint64_t key, int handle) {
+            const EmergencyCase &emergencyCase = other.payload(handle);
+            copyCase(payload(slotCount), emergencyCase);
+            engine.push(key, slotCount, emergencyCase.triageLevel);
+            statsAdd(slotCount, key);
+            deadlineAdd(slotCount, key);
+            
+            // Keep announced cases announced
+            if (other.overdueDeadlines.contains(handle))
+            {
+                pendingDeadlines.erase(slotCount);
+                overdueDeadlines.push(other.overdueDeadlines.keyOf(handle), slotCount, emergencyCase.triageLevel);
+            }
+            slotCount++;
+        });
+        
+        nextSequence = other.nextSequence;
+        indexRebuild(other.indexCapacity);
+    }
+    return *this;
 }
 
-// Get current size
-int PriorityQueue::getSize() const
+// Destructor
+PriorityQueue::~PriorityQueue()
 {
-    return size;
+    releaseChunks();
+    delete[] chunks;
+    delete[] freeSlots;
+    delete[] indexSlots;
+    delete[] indexHashes;
 }
 
-// Swap two elements in heap
-void PriorityQueue::swap(int i, int j)
+// Shared chunk pool
+ChunkPool<EmergencyCase, PriorityQueue::CHUNK_SIZE> &PriorityQueue::chunkPool()
 {
-    EmergencyCase temp = heap[i];
-    heap[i] = heap[j];
-    heap[j] = temp;
+    static ChunkPool<EmergencyCase, CHUNK_SIZE> pool;
+    return pool;
 }
 
 /*
- * HEAPIFY UP (Bubble Up)
- * Called after insertion to maintain min-heap property
- * 
- * Process:
- * 1. Compare new element with parent
- * 2. If new element has higher priority (lower value), swap with parent
- * 3. Repeat until heap property satisfied or reach root
+ * PACKED KEY
+ * [ priority key : 32 bits ][ sequence : 32 bits ]
  * 
- * Example:
- *        5              3  (after heapifyUp)
- *       / \            / \
- *      7   6    →     5   6
- *     /              /
- *    3              7
+ * One integer compare orders cases by triage + arrival (see
+ * EmergencyCase::getPriorityKey), then by insertion order.
+ * The priority key fits in 32 bits until the year 2106.
  */
-void PriorityQueue::heapifyUp(int index)
+uint64_t PriorityQueue::makeKey(const EmergencyCase &emergencyCase, uint32_t sequence)
 {
-    // If at root, stop
-    if (index == 0)
-        return;
+    long long priorityKey = emergencyCase.getPriorityKey();
+    if (priorityKey < 0)
+        priorityKey = 0;
+    
+    return (static_cast<uint64_t>(static_cast<uint32_t>(priorityKey)) << 32) 
+           | sequence;
+}
+
+// Get a payload slot (recycled one first)
+int PriorityQueue::allocateSlot()
+{
+    if (freeCount > 0)
+        return freeSlots[--freeCount];
     
-    int parentIndex = parent(index);
+    if (slotCount == getCapacity())
+        addChunk();
     
-    // If current node has higher priority than parent, swap
-    // (remember: lower priority score = higher priority)
-    if (heap[index] < heap[parentIndex])
+    return slotCount++;
+}
+
+// Return a payload slot to the free list
+void PriorityQueue::freeSlot(int h)
+{
+    if (freeCount == freeCapacity)
     {
-        swap(index, parentIndex);
-        heapifyUp(parentIndex);  // Recursively check parent
+        int newCapacity = freeCapacity == 0 ? 16 : freeCapacity * 2;
+        int *newArr = new int[newCapacity];
+        for (int i = 0; i < freeCount; i++)
+        {
+            newArr[i] = freeSlots[i];
+        }
+        delete[] freeSlots;
+        freeSlots = newArr;
+        freeCapacity = newCapacity;
+    }
+    
+    freeSlots[freeCount++] = h;
+}
+
+// Take one more chunk from the pool
+void PriorityQueue::addChunk()
+{
+    // Grow the chunk directory (only pointers are copied)
+    if (chunkCount == directoryCapacity)
+    {
+        int newCapacity = directoryCapacity == 0 ? 4 : directoryCapacity * 2;
+        EmergencyCase **newDirectory = new EmergencyCase *[newCapacity];
+        for (int i = 0; i < chunkCount; i++)
+        {
+            newDirectory[i] = chunks[i];
+        }
+        delete[] chunks;
+        chunks = newDirectory;
+        directoryCapacity = newCapacity;
+    }
+    
+    chunks[chunkCount++] = chunkPool().acquire();
+    
+    // Engine's per-handle tables cover every slot
+    engine.reserveHandles(getCapacity());
+    for (int l = 0; l < 5; l++)
+    {
+        oldestByLevel[l].reserveHandles(getCapacity());
+    }
+    pendingDeadlines.reserveHandles(getCapacity());
+    overdueDeadlines.reserveHandles(getCapacity());
+}
+
+// Give every chunk back to the pool
+void PriorityQueue::releaseChunks()
+{
+    while (chunkCount > 0)
+    {
+        chunkPool().release(chunks[--chunkCount]);
+    }
+}
+
+// Check if empty
+bool PriorityQueue::isEmpty() const
+{
+    return engine.isEmpty();
+}
+
+// Get current size
+int PriorityQueue::getSize() const
+{
+    return engine.getSize();
+}
+
+// Get current capacity
+int PriorityQueue::getCapacity() const
+{
+    return chunkCount * CHUNK_SIZE;
+}
+
+// Reserve room for `capacity` cases
+void PriorityQueue::reserve(int capacity)
+{
+    engine.reserve(capacity);
+    
+    while (getCapacity() < capacity)
+    {
+        addChunk();
     }
 }
 
 /*
- * HEAPIFY DOWN (Bubble Down)
- * Called after removal to maintain min-heap property
- * 
- * Process:
- * 1. Compare root with its children
- * 2. Find the child with highest priority (smallest value)
- * 3. If child has higher priority, swap with root
- * 4. Repeat for the subtree until heap property satisfied
+ * SHRINK TO FIT
+ * Cases sitting in slots >= size are moved down into free low slots,
+ * then every chunk above the last used slot goes back to the pool.
  * 
- * Example:
- *        7              3  (after heapifyDown)
- *       / \            / \
- *      3   6    →     7   6
- *     /              /
- *    5              5
+ * Time Complexity: O(n) (maintenance operation, not on the hot path)
  */
-void PriorityQueue::heapifyDown(int index)
+void PriorityQueue::shrinkToFit(bool releasePooled)
 {
-    int left = leftChild(index);
-    int right = rightChild(index);
-    int highest = index;  // Index of highest priority (lowest value)
+    int size = getSize();
     
-    // Check if left child has higher priority
-    if (left < size && heap[left] < heap[highest])
-        highest = left;
+    // Mark which low slots are taken
+    bool *used = new bool[size > 0 ? size : 1];
+    for (int h = 0; h < size; h++)
+    {
+        used[h] = false;
+    }
+    engine.forEach([&](uint64_t, int handle) {
+        if (handle < size)
+            used[handle] = true;
+    });
+    
+    // Move high cases into the gaps (newHandleOf[old slot] = new slot)
+    int *newHandleOf = new int[slotCount > 0 ? slotCount : 1];
+    int gap = 0;
+    engine.forEach([&](uint64_t, int handle) {
+        newHandleOf[handle] = handle;
+        if (handle >= size)
+        {
+            while (used[gap])
+                gap++;
+            
+            copyCase(payload(gap), payload(handle));
+            newHandleOf[handle] = gap;
+            used[gap] = true;
+        }
+    });
+    engine.remapHandles(newHandleOf);
+    for (int l = 0; l < 5; l++)
+    {
+        oldestByLevel[l].remapHandles(newHandleOf);
+    }
+    pendingDeadlines.remapHandles(newHandleOf);
+    overdueDeadlines.remapHandles(newHandleOf);
+    delete[] newHandleOf;
+    delete[] used;
     
-    // Check if right child has higher priority
-    if (right < size && heap[right] < heap[highest])
-        highest = right;
+    slotCount = size;
+    freeCount = 0;
+    indexRebuild(indexCapacity);
     
-    // If highest priority is not current node, swap and continue
-    if (highest != index)
+    int needed = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    while (chunkCount > needed)
     {
-        swap(index, highest);
-        heapifyDown(highest);  // Recursively fix subtree
+        chunkPool().release(chunks[--chunkCount]);
     }
+    
+    if (releasePooled)
+        chunkPool().trim(0);
 }
 
 /*
@@ -116,41 +264,54 @@ void PriorityQueue::heapifyDown(int index)
  * Add new emergency case with priority
  * 
  * Algorithm:
- * 1. Add element at end of array (maintain complete tree)
- * 2. Heapify up to restore heap property
+ * 1. Store the case in a payload slot
+ *    - take another chunk from the pool if the last one is full
+ * 2. Add the slot to the caseID index
+ * 3. Hand its { key, slot } entry to the ordering engine
  * 
- * Time Complexity: O(log n)
+ * Time Complexity: O(log n) heap engine, O(1) bucket engine
  */
 bool PriorityQueue::enqueue(const EmergencyCase& emergencyCase)
 {
-    if (isFull())
-    {
-        std::cout << C_RED << "\n✗ ERROR: Queue is full! Cannot add more cases." 
-                  << C_RESET << std::endl;
-        return false;
-    }
+    // Copy the case into a payload slot (the only copy while queued)
+    int h = allocateSlot();
+    copyCase(payload(h), emergencyCase);
     
-    // Insert at end
-    heap[size] = emergencyCase;
+    // Index first: a growing index is rebuilt from the engine's entries
+    indexInsert(h);
+    uint64_t key = makeKey(emergencyCase, nextSequence++);
+    engine.push(key, h, emergencyCase.triageLevel);
+    statsAdd(h, key);
+    deadlineAdd(h, key);
     
-    // Restore heap property
-    heapifyUp(size);
-    
-    size++;
     return true;
 }
 
+/*
+ * ENQUEUE BATCH (Bulk insert)
+ * Used for importing the case file and for mass-casualty intake.
+ * Each case is copied into its slot and gets the next sequence number;
+ * the rest is insertBatch (one growth, one engine bulk insert).
+ * 
+ * Time Complexity: O(n + k) (O(k log n) for a batch small next to n)
+ */
+int PriorityQueue::enqueueBatch(const EmergencyCase cases[], int count)
+{
+    return insertBatch(count, [&](int i, EmergencyCase &slot) {
+        copyCase(slot, cases[i]);
+        return nextSequence++;
+    });
+}
+
 /*
  * DEQUEUE (Remove highest priority)
- * Remove and return the root (highest priority case)
+ * Remove and return the engine's top (highest priority case)
  * 
  * Algorithm:
- * 1. Save root element (highest priority)
- * 2. Replace root with last element
- * 3. Reduce size
- * 4. Heapify down to restore heap property
+ * 1. Copy out the top case
+ * 2. Remove it from the engine, the caseID index and its slot
  * 
- * Time Complexity: O(log n)
+ * Time Complexity: O(log n) heap engine, O(1) amortized bucket engine
  */
 bool PriorityQueue::dequeue(EmergencyCase& emergencyCase)
 {
@@ -161,23 +322,18 @@ bool PriorityQueue::dequeue(EmergencyCase& emergencyCase)
         return false;
     }
     
-    // Get root (highest priority)
-    emergencyCase = heap[0];
+    // Get top (highest priority)
+    int h = engine.top();
+    copyCase(emergencyCase, payload(h));
     
-    // Move last element to root
-    heap[0] = heap[size - 1];
-    size--;
-    
-    // Restore heap property if queue not empty
-    if (size > 0)
-        heapifyDown(0);
+    removeCase(h);
     
     return true;
 }
 
 /*
  * PEEK (View highest priority without removing)
- * Return root element without modifying heap
+ * Return top element without modifying the queue
  * 
  * Time Complexity: O(1)
  */
@@ -190,18 +346,44 @@ bool PriorityQueue::peek(EmergencyCase& emergencyCase) const
         return false;
     }
     
-    emergencyCase = heap[0];
+    copyCase(emergencyCase, payload(engine.top()));
     return true;
 }
 
 /*
- * DISPLAY ALL CASES
- * Show all cases in priority order
+ * TOP CASES (Ordered page of the queue)
+ * The engine walks its first offset + k entries in priority order
+ * (frontier heap of indices, see FrontierHeap) and only the requested
+ * page of cases is copied out.
  * 
- * Method: Create temporary copy and repeatedly extract highest priority
- * This preserves original heap structure
+ * Time Complexity: O((offset + k) log (offset + k))
  */
-void PriorityQueue::display() const
+int PriorityQueue::getTopCases(EmergencyCase cases[], int k, int offset) const
+{
+    if (k <= 0 || offset < 0 || offset >= getSize())
+        return 0;
+    
+    int *handles = new int[offset + k];
+    int count = engine.topK(offset + k, handles) - offset;
+    
+    for (int i = 0; i < count; i++)
+    {
+        copyCase(cases[i], payload(handles[offset + i]));
+    }
+    
+    delete[] handles;
+    return count;
+}
+
+/*
+ * DISPLAY CASES
+ * Show a range of cases in priority order
+ * 
+ * Method: Ask the engine for its first (first + count) handles in
+ * priority order and print those cases straight from their slots.
+ * Nothing is copied and the queue is not modified.
+ */
+void PriorityQueue::display(int first, int count) const
 {
     if (isEmpty())
     {
@@ -215,75 +397,432 @@ void PriorityQueue::display() const
               << C_RESET << std::endl;
     std::cout << C_CYAN << std::string(60, '=') << C_RESET << std::endl;
     
-    // Create temporary queue for display
-    PriorityQueue tempQueue;
-    for (int i = 0; i < size; i++)
-    {
-        tempQueue.enqueue(heap[i]);
-    }
+    if (first < 0)
+        first = 0;
+    if (count < 0 || first + count > getSize())
+        count = getSize() - first;
     
-    int position = 1;
-    EmergencyCase currentCase;
+    int *handles = new int[first + count > 0 ? first + count : 1];
+    int shown = engine.topK(first + count, handles);
     
-    while (!tempQueue.isEmpty())
+    for (int i = first; i < shown; i++)
     {
-        tempQueue.dequeue(currentCase);
-        
-        std::cout << "\n" << C_BOLD << "Priority #" << position++ 
+        std::cout << "\n" << C_BOLD << "Priority #" << (i + 1) 
                   << C_RESET << std::endl;
-        currentCase.display();
+        payload(handles[i]).display();
     }
+    delete[] handles;
     
     std::cout << "\n" << C_CYAN << std::string(60, '=') << C_RESET << std::endl;
-    std::cout << C_BOLD << "Total Cases: " << size << C_RESET << std::endl;
+    if (shown > first && (first > 0 || shown < getSize()))
+    {
+        std::cout << C_BOLD << "Showing " << (first + 1) << "-" << shown 
+                  << " of " << getSize() << " cases" << C_RESET << std::endl;
+    }
+    else
+    {
+        std::cout << C_BOLD << "Total Cases: " << getSize() << C_RESET << std::endl;
+    }
     std::cout << C_CYAN << std::string(60, '=') << C_RESET << std::endl;
 }
 
-// Update waiting times for all cases
-void PriorityQueue::updateWaitingTimes()
+// Get all cases as array
+void PriorityQueue::getAllCases(EmergencyCase cases[], int& count) const
+{
+    count = 0;
+    engine.forEach([&](uint64_t, int handle) {
+        copyCase(cases[count++], payload(handle));
+    });
+}
+
+// Clear all cases (chunks are kept for reuse, see shrinkToFit)
+void PriorityQueue::clear()
+{
+    engine.clear();
+    statsReset();
+    pendingDeadlines.clear();
+    overdueDeadlines.clear();
+    for (int i = 0; i < indexCapacity; i++)
+    {
+        indexSlots[i] = -1;
+    }
+    
+    slotCount = 0;
+    freeCount = 0;
+    indexCount = 0;
+}
+
+// Remove a case from the engine, drop it from the index, free its slot
+void PriorityQueue::removeCase(int h)
+{
+    statsRemove(h);
+    deadlineRemove(h);
+    engine.erase(h);
+    indexErase(h);
+    freeSlot(h);
+}
+
+// Search for case by ID (hash lookup)
+bool PriorityQueue::findCase(const std::string& caseID, EmergencyCase& foundCase) const
+{
+    int h = indexFind(caseID);
+    if (h < 0)
+        return false;
+    
+    copyCase(foundCase, payload(h));
+    return true;
+}
+
+/*
+ * UPDATE TRIAGE (Re-triage in place)
+ * The priority part of the key is recomputed, the sequence number is
+ * kept, and the engine moves the entry (heap: sift from where it sits,
+ * buckets: move to the new level's ring).
+ * 
+ * Time Complexity: O(log n) heap engine, O(1) amortized bucket engine
+ */
+bool PriorityQueue::updateTriage(const std::string& caseID, TriageLevel newLevel)
+{
+    int h = indexFind(caseID);
+    if (h < 0)
+        return false;
+    
+    // The new level brings a new deadline (announced again if overdue)
+    statsRemove(h);
+    deadlineRemove(h);
+    payload(h).triageLevel = newLevel;
+    
+    uint32_t sequence = static_cast<uint32_t>(engine.keyOf(h) & 0xFFFFFFFFu);
+    uint64_t key = makeKey(payload(h), sequence);
+    engine.changeKey(h, key, newLevel);
+    statsAdd(h, key);
+    deadlineAdd(h, key);
+    
+    return true;
+}
+
+// Cancel a case (left without being seen)
+bool PriorityQueue::cancelCase(const std::string& caseID, EmergencyCase& cancelledCase)
+{
+    int h = indexFind(caseID);
+    if (h < 0)
+        return false;
+    
+    copyCase(cancelledCase, payload(h));
+    removeCase(h);
+    return true;
+}
+
+/* ==================== Running Statistics ==================== */
+
+// Count a stored case (key = its engine key)
+void PriorityQueue::statsAdd(int h, uint64_t key)
+{
+    const EmergencyCase &emergencyCase = payload(h);
+    levelCount[emergencyCase.triageLevel]++;
+    typeCount[emergencyCase.emergencyType]++;
+    arrivalSum += emergencyCase.arrivalEpoch;
+    oldestByLevel[emergencyCase.triageLevel - 1].push(key, h, emergencyCase.triageLevel);
+}
+
+// Count a batch of stored cases; each level's heap is built in bulk
+void PriorityQueue::statsAddBatch(const uint64_t keys[], const int handles[], const int levels[], int count)
 {
-    for (int i = 0; i < size; i++)
+    for (int i = 0; i < count; i++)
     {
-        heap[i].waitingMinutes = calculateWaitingTime(
-            heap[i].arrivalTime, 
-            heap[i].arrivalDate
-        );
+        const EmergencyCase &emergencyCase = payload(handles[i]);
+        levelCount[levels[i]]++;
+        typeCount[emergencyCase.emergencyType]++;
+        arrivalSum += emergencyCase.arrivalEpoch;
     }
     
-    // After updating waiting times, priorities may change
-    // Rebuild heap to ensure correct priority order
-    for (int i = size / 2 - 1; i >= 0; i--)
+    uint64_t *levelKeys = new uint64_t[count];
+    int *levelHandles = new int[count];
+    int *levelLevels = new int[count];
+    for (int level = RESUSCITATION; level <= NON_URGENT; level++)
     {
-        heapifyDown(i);
+        int n = 0;
+        for (int i = 0; i < count; i++)
+        {
+            if (levels[i] != level)
+                continue;
+            
+            levelKeys[n] = keys[i];
+            levelHandles[n] = handles[i];
+            levelLevels[n] = level;
+            n++;
+        }
+        oldestByLevel[level - 1].pushBatch(levelKeys, levelHandles, levelLevels, n);
     }
+    delete[] levelKeys;
+    delete[] levelHandles;
+    delete[] levelLevels;
 }
 
-// Get all cases as array
-void PriorityQueue::getAllCases(EmergencyCase cases[], int& count) const
+// Stop counting a case (call before its triage level changes)
+void PriorityQueue::statsRemove(int h)
 {
-    count = size;
-    for (int i = 0; i < size; i++)
+    const EmergencyCase &emergencyCase = payload(h);
+    levelCount[emergencyCase.triageLevel]--;
+    typeCount[emergencyCase.emergencyType]--;
+    arrivalSum -= emergencyCase.arrivalEpoch;
+    oldestByLevel[emergencyCase.triageLevel - 1].erase(h);
+}
+
+// Zero every counter
+void PriorityQueue::statsReset()
+{
+    for (int i = 0; i < 6; i++)
     {
-        cases[i] = heap[i];
+        levelCount[i] = 0;
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        typeCount[i] = 0;
+    }
+    arrivalSum = 0;
+    for (int l = 0; l < 5; l++)
+    {
+        oldestByLevel[l].clear();
     }
 }
 
-// Clear all cases
-void PriorityQueue::clear()
+int PriorityQueue::countAtLevel(TriageLevel level) const
 {
-    size = 0;
+    return levelCount[level];
 }
 
-// Search for case by ID
-bool PriorityQueue::findCase(const std::string& caseID, EmergencyCase& foundCase) const
+int PriorityQueue::countOfType(EmergencyType type) const
+{
+    return typeCount[type];
+}
+
+// Oldest arrival at a level: top of that level's heap
+time_t PriorityQueue::oldestArrival(TriageLevel level) const
+{
+    const IndexedDaryHeap<4> &oldest = oldestByLevel[level - 1];
+    if (oldest.isEmpty())
+        return 0;
+    
+    return payload(oldest.top()).arrivalEpoch;
+}
+
+// sum(now - arrival) = size * now - sum(arrival)
+long long PriorityQueue::totalWaitingSeconds(time_t now) const
+{
+    long long total = static_cast<long long>(getSize()) * now - arrivalSum;
+    return total > 0 ? total : 0;
+}
+
+// Longest wait = oldest arrival over the 5 levels
+int PriorityQueue::longestWaitMinutes(time_t now) const
+{
+    time_t oldest = 0;
+    for (int level = RESUSCITATION; level <= NON_URGENT; level++)
+    {
+        time_t arrival = oldestArrival(static_cast<TriageLevel>(level));
+        if (arrival != 0 && (oldest == 0 || arrival < oldest))
+            oldest = arrival;
+    }
+    
+    if (oldest == 0 || now <= oldest)
+        return 0;
+    return static_cast<int>((now - oldest) / 60);
+}
+
+/* ==================== Escalation Deadlines ==================== */
+
+// Queue a case's deadline (key = its engine key, for the sequence)
+void PriorityQueue::deadlineAdd(int h, uint64_t key)
+{
+    const EmergencyCase &emergencyCase = payload(h);
+    time_t deadline = emergencyCase.getEscalationDeadline();
+    if (deadline == 0)
+        return;
+    
+    uint64_t deadlineKey = (static_cast<uint64_t>(static_cast<uint32_t>(deadline)) << 32)
+                           | (key & 0xFFFFFFFFu);
+    pendingDeadlines.push(deadlineKey, h, emergencyCase.triageLevel);
+}
+
+// Queue the deadlines of a batch of cases in one bulk insert
+void PriorityQueue::deadlineAddBatch(const uint64_t keys[], const int handles[], const int levels[], int count)
+{
+    uint64_t *deadlineKeys = new uint64_t[count];
+    int *deadlineHandles = new int[count];
+    int *deadlineLevels = new int[count];
+    int n = 0;
+    for (int i = 0; i < count; i++)
+    {
+        time_t deadline = payload(handles[i]).getEscalationDeadline();
+        if (deadline == 0)
+            continue;
+        
+        deadlineKeys[n] = (static_cast<uint64_t>(static_cast<uint32_t>(deadline)) << 32)
+                          | (keys[i] & 0xFFFFFFFFu);
+        deadlineHandles[n] = handles[i];
+        deadlineLevels[n] = levels[i];
+        n++;
+    }
+    pendingDeadlines.pushBatch(deadlineKeys, deadlineHandles, deadlineLevels, n);
+    
+    delete[] deadlineKeys;
+    delete[] deadlineHandles;
+    delete[] deadlineLevels;
+}
+
+// Forget a case's deadline, announced or not
+void PriorityQueue::deadlineRemove(int h)
+{
+    pendingDeadlines.erase(h);
+    overdueDeadlines.erase(h);
+}
+
+void PriorityQueue::setEscalationListener(EscalationListener *listener)
+{
+    escalationListener = listener;
+}
+
+/*
+ * ADVANCE ESCALATIONS
+ * Pending deadlines come out of the heap in time order; stop at the
+ * first one still in the future.
+ * 
+ * Time Complexity: O(k log n) for k newly overdue cases, O(1) if none
+ */
+int PriorityQueue::advanceEscalations(time_t now)
+{
+    uint64_t limit = (static_cast<uint64_t>(static_cast<uint32_t>(now)) << 32) | 0xFFFFFFFFu;
+    int crossed = 0;
+    
+    while (!pendingDeadlines.isEmpty() && pendingDeadlines.topKey() <= limit)
+    {
+        int h = pendingDeadlines.top();
+        uint64_t deadlineKey = pendingDeadlines.topKey();
+        pendingDeadlines.pop();
+        overdueDeadlines.push(deadlineKey, h, payload(h).triageLevel);
+        crossed++;
+        
+        if (escalationListener != nullptr)
+            escalationListener->onEscalation(payload(h), now);
+    }
+    return crossed;
+}
+
+int PriorityQueue::overdueCount(time_t now)
 {
-    for (int i = 0; i < size; i++)
+    advanceEscalations(now);
+    return overdueDeadlines.getSize();
+}
+
+/* ==================== caseID Hash Index ==================== */
+
+// FNV-1a hash of the case ID
+uint32_t PriorityQueue::hashCaseID(const std::string &caseID)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < caseID.length(); i++)
     {
-        if (heap[i].caseID == caseID)
+        hash ^= static_cast<unsigned char>(caseID[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Find the slot handle for a case ID (-1 if absent)
+int PriorityQueue::indexFind(const std::string &caseID) const
+{
+    if (indexCount == 0)
+        return -1;
+    
+    uint32_t hash = hashCaseID(caseID);
+    int mask = indexCapacity - 1;
+    
+    for (int i = hash & mask; indexSlots[i] != -1; i = (i + 1) & mask)
+    {
+        if (indexHashes[i] == hash && payload(indexSlots[i]).caseID == caseID)
+            return indexSlots[i];
+    }
+    return -1;
+}
+
+// Add a stored case to the index (table kept at most half full)
+void PriorityQueue::indexInsert(int h)
+{
+    if ((indexCount + 1) * 2 > indexCapacity)
+        indexRebuild(indexCapacity == 0 ? 64 : indexCapacity * 2);
+    
+    uint32_t hash = hashCaseID(payload(h).caseID);
+    int mask = indexCapacity - 1;
+    int i = hash & mask;
+    
+    while (indexSlots[i] != -1)
+        i = (i + 1) & mask;
+    
+    indexSlots[i] = h;
+    indexHashes[i] = hash;
+    indexCount++;
+}
+
+/*
+ * Remove a handle from the index
+ * Linear probing needs no tombstones: later entries of the same probe
+ * run are shifted back into the gap ("backward shift deletion").
+ */
+void PriorityQueue::indexErase(int h)
+{
+    uint32_t hash = hashCaseID(payload(h).caseID);
+    int mask = indexCapacity - 1;
+    int i = hash & mask;
+    
+    while (indexSlots[i] != h)
+    {
+        if (indexSlots[i] == -1)
+            return;
+        i = (i + 1) & mask;
+    }
+    
+    int j = i;
+    while (true)
+    {
+        j = (j + 1) & mask;
+        if (indexSlots[j] == -1)
+            break;
+        
+        // Entry at j may move to i only if i lies on its probe path
+        int home = indexHashes[j] & mask;
+        if (((j - home) & mask) >= ((j - i) & mask))
         {
-            foundCase = heap[i];
-            return true;
+            indexSlots[i] = indexSlots[j];
+            indexHashes[i] = indexHashes[j];
+            i = j;
         }
     }
-    return false;
+    
+    indexSlots[i] = -1;
+    indexCount--;
+}
+
+// Re-create the index from the engine's entries
+void PriorityQueue::indexRebuild(int capacity)
+{
+    int newCapacity = 64;
+    while (newCapacity < capacity || newCapacity < getSize() * 2)
+        newCapacity *= 2;
+    
+    delete[] indexSlots;
+    delete[] indexHashes;
+    indexSlots = new int[newCapacity];
+    indexHashes = new uint32_t[newCapacity];
+    indexCapacity = newCapacity;
+    indexCount = 0;
+    
+    for (int i = 0; i < indexCapacity; i++)
+    {
+        indexSlots[i] = -1;
+    }
+    
+    engine.forEach([&](uint64_t, int handle) {
+        indexInsert(handle);
+    });
 }
\ No newline at end of file
@@ -0,0 +1,401 @@
+#include "core_library/emergency_department/triage_buckets.hpp"
+
+// Constructor
+TriageBuckets::TriageBuckets()
+    : occupied(0), size(0), keys(nullptr), stamps(nullptr), levels(nullptr), handleCapacity(0)
+{
+    for (int l = 0; l < LEVELS; l++)
+    {
+        rings[l].data = nullptr;
+        rings[l].capacity = 0;
+        rings[l].head = 0;
+        rings[l].count = 0;
+        liveCount[l] = 0;
+    }
+}
+
+// Destructor
+TriageBuckets::~TriageBuckets()
+{
+    for (int l = 0; l < LEVELS; l++)
+    {
+        delete[] rings[l].data;
+    }
+    delete[] keys;
+    delete[] stamps;
+    delete[] levels;
+}
+
+// Grow a ring to at least `capacity` entries (unwrapped to head = 0)
+void TriageBuckets::growRing(Ring &ring, int capacity)
+{
+    if (capacity <= ring.capacity)
+        return;
+    
+    int newCapacity = ring.capacity == 0 ? 16 : ring.capacity;
+    while (newCapacity < capacity)
+        newCapacity *= 2;
+    
+    Entry *newData = new Entry[newCapacity];
+    for (int i = 0; i < ring.count; i++)
+    {
+        newData[i] = ring.at(i);
+    }
+    delete[] ring.data;
+    ring.data = newData;
+    ring.capacity = newCapacity;
+    ring.head = 0;
+}
+
+// Spread the reservation over the rings
+void TriageBuckets::reserve(int capacity)
+{
+    int perLevel = capacity / LEVELS + 1;
+    for (int l = 0; l < LEVELS; l++)
+    {
+        growRing(rings[l], perLevel);
+    }
+}
+
+// Grow the per-handle arrays
+void TriageBuckets::reserveHandles(int capacity)
+{
+    if (capacity <= handleCapacity)
+        return;
+    
+    int newCapacity = handleCapacity == 0 ? 16 : handleCapacity;
+    while (newCapacity < capacity)
+        newCapacity *= 2;
+    
+    uint64_t *newKeys = new uint64_t[newCapacity];
+    uint32_t *newStamps = new uint32_t[newCapacity];
+    unsigned char *newLevels = new unsigned char[newCapacity];
+    for (int i = 0; i < handleCapacity; i++)
+    {
+        newKeys[i] = keys[i];
+        newStamps[i] = stamps[i];
+        newLevels[i] = levels[i];
+    }
+    for (int i = handleCapacity; i < newCapacity; i++)
+    {
+        newKeys[i] = NOT_QUEUED;
+        newStamps[i] = 0;
+        newLevels[i] = 0;
+    }
+    delete[] keys;
+    delete[] stamps;
+    delete[] levels;
+    keys = newKeys;
+    stamps = newStamps;
+    levels = newLevels;
+    handleCapacity = newCapacity;
+}
+
+// Advance a ring's head past stale entries
+void TriageBuckets::dropStaleHead(int level)
+{
+    Ring &ring = rings[level];
+    while (ring.count > 0 && !isLive(ring.at(0)))
+    {
+        ring.head = (ring.head + 1) & (ring.capacity - 1);
+        ring.count--;
+    }
+}
+
+// Squeeze stale entries out of a ring (order is kept)
+void TriageBuckets::compactRing(int level)
+{
+    Ring &ring = rings[level];
+    int kept = 0;
+    for (int i = 0; i < ring.count; i++)
+    {
+        if (isLive(ring.at(i)))
+            ring.at(kept++) = ring.at(i);
+    }
+    ring.count = kept;
+}
+
+/*
+ * BEST LEVEL
+ * The key already folds triage level and arrival time together
+ * (see EmergencyCase::getPriorityKey), so the winner is just the
+ * smallest head among the occupied levels.
+ */
+int TriageBuckets::bestLevel() const
+{
+    int best = 0;
+    for (int l = 0; l < LEVELS; l++)
+    {
+        if ((occupied & (1u << l)) == 0)
+            continue;
+        
+        if (best == 0 || rings[l].at(0).key < rings[best - 1].at(0).key)
+            best = l + 1;
+    }
+    return best;
+}
+
+// Smallest of the best ring head and the side heap's top
+int TriageBuckets::topHandle() const
+{
+    int best = bestLevel();
+    if (best == 0)
+        return outOfOrder.top();
+    
+    const Entry &head = rings[best - 1].at(0);
+    if (!outOfOrder.isEmpty() && outOfOrder.topKey() < head.key)
+        return outOfOrder.top();
+    
+    return head.handle;
+}
+
+/*
+ * PUSH
+ * Append to the level's ring when the key is not smaller than the
+ * ring's tail (the normal case: arrivals come in time order),
+ * otherwise hand the entry to the side heap.
+ * 
+ * Time Complexity: O(1) in order, O(log m) out of order
+ */
+void TriageBuckets::push(uint64_t key, int handle, int level)
+{
+    if (!appendToRing(key, handle, level))
+        outOfOrder.push(key, handle, level);
+}
+
+// Record the entry's key and level, and append it to its level's ring if
+// the key fits the tail (false = the caller puts it in the side heap)
+bool TriageBuckets::appendToRing(uint64_t key, int handle, int level)
+{
+    reserveHandles(handle + 1);
+    
+    int l = level - 1;
+    keys[handle] = key;
+    levels[handle] = static_cast<unsigned char>(level);
+    size++;
+    
+    // Stale entries at the tail would only push keys off to the side heap
+    Ring &ring = rings[l];
+    while (ring.count > 0 && !isLive(ring.at(ring.count - 1)))
+        ring.count--;
+    
+    if (ring.count > 0 && key < ring.at(ring.count - 1).key)
+        return false;
+    
+    growRing(ring, ring.count + 1);
+    Entry entry = { key, handle, ++stamps[handle] };
+    ring.at(ring.count++) = entry;
+    
+    liveCount[l]++;
+    occupied |= 1u << l;
+    return true;
+}
+
+/*
+ * PUSH BATCH
+ * Entries that fit their ring's tail are appended as usual; the rest
+ * are collected and handed to the side heap in one bulk insert.
+ * 
+ * Time Complexity: O(k + m) for m out-of-order entries in a large batch
+ */
+void TriageBuckets::pushBatch(const uint64_t batchKeys[], const int batchHandles[], const int batchLevels[], int count)
+{
+    uint64_t *lateKeys = new uint64_t[count > 0 ? count : 1];
+    int *lateHandles = new int[count > 0 ? count : 1];
+    int *lateLevels = new int[count > 0 ? count : 1];
+    int lateCount = 0;
+    
+    for (int i = 0; i < count; i++)
+    {
+        if (!appendToRing(batchKeys[i], batchHandles[i], batchLevels[i]))
+        {
+            lateKeys[lateCount] = batchKeys[i];
+            lateHandles[lateCount] = batchHandles[i];
+            lateLevels[lateCount] = batchLevels[i];
+            lateCount++;
+        }
+    }
+    outOfOrder.pushBatch(lateKeys, lateHandles, lateLevels, lateCount);
+    
+    delete[] lateKeys;
+    delete[] lateHandles;
+    delete[] lateLevels;
+}
+
+// Remove the highest priority entry
+void TriageBuckets::pop()
+{
+    erase(top());
+}
+
+/*
+ * ERASE
+ * Side heap entries are removed from the heap. For ring entries, bump
+ * the handle's stamp so the entry turns stale, then restore the
+ * "heads are live" rule for that ring.
+ * 
+ * Time Complexity: O(1) amortized
+ */
+void TriageBuckets::erase(int handle)
+{
+    if (!contains(handle))
+        return;
+    
+    keys[handle] = NOT_QUEUED;
+    size--;
+    
+    if (outOfOrder.contains(handle))
+    {
+        outOfOrder.erase(handle);
+        return;
+    }
+    
+    int l = levels[handle] - 1;
+    stamps[handle]++;
+    liveCount[l]--;
+    
+    Ring &ring = rings[l];
+    if (liveCount[l] == 0)
+    {
+        ring.head = 0;
+        ring.count = 0;
+        occupied &= ~(1u << l);
+        return;
+    }
+    
+    dropStaleHead(l);
+    if (ring.count > 2 * liveCount[l] && ring.count >= 32)
+        compactRing(l);
+}
+
+// Re-key: leave the old ring, join the new one
+void TriageBuckets::changeKey(int handle, uint64_t key, int level)
+{
+    if (keys[handle] == key && levels[handle] == level)
+        return;
+    
+    erase(handle);
+    push(key, handle, level);
+}
+
+/*
+ * TOP K (Ordered view without modifying the rings)
+ * Every ring is already sorted, and the side heap gives its own top K
+ * in order, so the first K entries come from a 6-way merge: one cursor
+ * per ring (skipping stale entries) plus one into the side heap list.
+ * 
+ * Time Complexity: O(K) + side heap's O(K log K) + stale entries skipped
+ */
+int TriageBuckets::topK(int k, int out[]) const
+{
+    if (k > size)
+        k = size;
+    if (k <= 0)
+        return 0;
+    
+    int *side = new int[k];
+    int sideCount = outOfOrder.topK(k, side);
+    int sideNext = 0;
+    int cursor[LEVELS] = { 0 };
+    
+    int count = 0;
+    while (count < k)
+    {
+        int best = -1;    // Level index, or LEVELS for the side heap
+        uint64_t bestKey = 0;
+        
+        for (int l = 0; l < LEVELS; l++)
+        {
+            const Ring &ring = rings[l];
+            while (cursor[l] < ring.count && !isLive(ring.at(cursor[l])))
+                cursor[l]++;
+            
+            if (cursor[l] < ring.count && (best < 0 || ring.at(cursor[l]).key < bestKey))
+            {
+                best = l;
+                bestKey = ring.at(cursor[l]).key;
+            }
+        }
+        if (sideNext < sideCount && (best < 0 || keys[side[sideNext]] < bestKey))
+            best = LEVELS;
+        
+        if (best == LEVELS)
+            out[count++] = side[sideNext++];
+        else
+            out[count++] = rings[best].at(cursor[best]++).handle;
+    }
+    
+    delete[] side;
+    return count;
+}
+
+// Rename handles after the owner compacted its payload slots
+void TriageBuckets::remapHandles(const int *newHandleOf)
+{
+    uint64_t *newKeys = new uint64_t[handleCapacity];
+    uint32_t *newStamps = new uint32_t[handleCapacity];
+    unsigned char *newLevels = new unsigned char[handleCapacity];
+    for (int i = 0; i < handleCapacity; i++)
+    {
+        newKeys[i] = NOT_QUEUED;
+        newStamps[i] = 0;
+        newLevels[i] = 0;
+    }
+    
+    outOfOrder.forEach([&](uint64_t key, int handle) {
+        int h = newHandleOf[handle];
+        newKeys[h] = key;
+        newLevels[h] = levels[handle];
+    });
+    outOfOrder.remapHandles(newHandleOf);
+    
+    // Stale entries name old handles, drop them before renaming
+    for (int l = 0; l < LEVELS; l++)
+    {
+        compactRing(l);
+        
+        for (int i = 0; i < rings[l].count; i++)
+        {
+            Entry &entry = rings[l].at(i);
+            int h = newHandleOf[entry.handle];
+            newKeys[h] = keys[entry.handle];
+            newStamps[h] = entry.stamp;
+            newLevels[h] = levels[entry.handle];
+            entry.handle = h;
+        }
+    }
+    
+    delete[] keys;
+    delete[] stamps;
+    delete[] levels;
+    keys = newKeys;
+    stamps = newStamps;
+    levels = newLevels;
+}
+
+// Remove every entry
+void TriageBuckets::clear()
+{
+    outOfOrder.forEach([&](uint64_t, int handle) {
+        keys[handle] = NOT_QUEUED;
+    });
+    outOfOrder.clear();
+    
+    for (int l = 0; l < LEVELS; l++)
+    {
+        for (int i = 0; i < rings[l].count; i++)
+        {
+            const Entry &entry = rings[l].at(i);
+            if (isLive(entry))
+            {
+                keys[entry.handle] = NOT_QUEUED;
+                stamps[entry.handle]++;
+            }
+        }
+        rings[l].head = 0;
+        rings[l].count = 0;
+        liveCount[l] = 0;
+    }
+    occupied = 0;
+    size = 0;
+}
@@ -0,0 +1,131 @@
+#include "core_library/emergency_department/wait_histogram.hpp"
+
+// Constructor
+WaitHistogram::WaitHistogram()
+{
+    reset();
+}
+
+// Forget every value
+void WaitHistogram::reset()
+{
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        counts[i] = 0;
+    }
+    totalCount = 0;
+    totalSeconds = 0;
+    minSeconds = 0;
+    maxSeconds = 0;
+}
+
+/*
+ * BUCKET OF A VALUE
+ * The highest set bit is found with a 5-step binary search, so the
+ * cost does not depend on the value.
+ */
+int WaitHistogram::bucketOf(long long seconds)
+{
+    if (seconds < SUB_BUCKETS)
+        return static_cast<int>(seconds);
+    if (seconds >= (1LL << MAX_BITS))
+        return BUCKETS - 1;
+    
+    uint32_t v = static_cast<uint32_t>(seconds);
+    int highestBit = 0;
+    if (v >= (1u << 16)) { v >>= 16; highestBit += 16; }
+    if (v >= (1u << 8))  { v >>= 8;  highestBit += 8; }
+    if (v >= (1u << 4))  { v >>= 4;  highestBit += 4; }
+    if (v >= (1u << 2))  { v >>= 2;  highestBit += 2; }
+    if (v >= (1u << 1))  { highestBit += 1; }
+    
+    int shift = highestBit - 5;
+    int top = static_cast<int>(seconds >> shift);
+    return SUB_BUCKETS + (shift - 1) * HALF_BUCKETS + (top - HALF_BUCKETS);
+}
+
+// Largest value that falls into a bucket (inverse of bucketOf)
+long long WaitHistogram::highestInBucket(int index)
+{
+    if (index < SUB_BUCKETS)
+        return index;
+    
+    int shift = (index - SUB_BUCKETS) / HALF_BUCKETS + 1;
+    long long top = (index - SUB_BUCKETS) % HALF_BUCKETS + HALF_BUCKETS;
+    return ((top + 1) << shift) - 1;
+}
+
+// Count one wait
+void WaitHistogram::record(long long seconds)
+{
+    if (seconds < 0)
+        seconds = 0;
+    
+    counts[bucketOf(seconds)]++;
+    if (totalCount == 0 || seconds < minSeconds)
+        minSeconds = seconds;
+    if (seconds > maxSeconds)
+        maxSeconds = seconds;
+    totalCount++;
+    totalSeconds += seconds;
+}
+
+double WaitHistogram::getMean() const
+{
+    if (totalCount == 0)
+        return 0.0;
+    return static_cast<double>(totalSeconds) / static_cast<double>(totalCount);
+}
+
+/*
+ * PERCENTILE
+ * Walk the buckets from the smallest, until the running count reaches
+ * percentile% of all values; report that bucket's largest value
+ * (never more than the largest value actually recorded).
+ */
+long long WaitHistogram::valueAtPercentile(double percentile) const
+{
+    if (totalCount == 0)
+        return 0;
+    
+    if (percentile < 0.0)
+        percentile = 0.0;
+    if (percentile > 100.0)
+        percentile = 100.0;
+    
+    // Rank of the value asked for: ceil(percentile% of the count), >= 1
+    double rank = percentile / 100.0 * static_cast<double>(totalCount);
+    uint64_t target = static_cast<uint64_t>(rank);
+    if (static_cast<double>(target) < rank || target == 0)
+        target++;
+    
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        seen += counts[i];
+        if (seen >= target)
+        {
+            long long value = highestInBucket(i);
+            return value < maxSeconds ? value : maxSeconds;
+        }
+    }
+    return maxSeconds;
+}
+
+// Add another histogram's counts to this one
+void WaitHistogram::add(const WaitHistogram &other)
+{
+    if (other.totalCount == 0)
+        return;
+    
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        counts[i] += other.counts[i];
+    }
+    if (totalCount == 0 || other.minSeconds < minSeconds)
+        minSeconds = other.minSeconds;
+    if (other.maxSeconds > maxSeconds)
+        maxSeconds = other.maxSeconds;
+    totalCount += other.totalCount;
+    totalSeconds += other.totalSeconds;
+}